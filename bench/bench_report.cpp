@@ -0,0 +1,52 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "bench_report.h"
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+SampleSummary summarize(std::vector<double> samples) {
+    SampleSummary summary;
+    if (samples.empty())
+        return summary;
+
+    std::sort(samples.begin(), samples.end());
+    summary.count = samples.size();
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+    summary.p50 = percentile(samples, 50);
+    summary.p95 = percentile(samples, 95);
+    summary.p99 = percentile(samples, 99);
+    summary.max = samples.back();
+    return summary;
+}
+
+void writeSummary(FILE* file, const char* name, const SampleSummary& summary) {
+    fprintf(file, "\"%s\": ", name);
+    if (summary.count == 0) {
+        fprintf(file, "null");
+        return;
+    }
+    fprintf(file, "{\"count\": %zu, \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+            summary.count, summary.mean, summary.p50, summary.p95, summary.p99, summary.max);
+}
+
+void writeString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\')
+            fprintf(file, "\\%c", *c);
+        else if (static_cast<unsigned char>(*c) < 0x20)
+            fprintf(file, "\\u%04x", *c);
+        else
+            fputc(*c, file);
+    }
+    fputc('"', file);
+}
@@ -0,0 +1,30 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_BENCH_REPORT_H
+#define ZPG_BENCH_REPORT_H
+
+#include <cstdio>
+#include <vector>
+
+struct SampleSummary {
+    size_t count = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p95 = 0;
+    double p99 = 0;
+    double max = 0;
+};
+
+// nearest-rank percentiles of the samples
+SampleSummary summarize(std::vector<double> samples);
+
+// "name": {"count": .., "mean": .., "p50": .., ...}, null when there are no samples
+void writeSummary(FILE* file, const char* name, const SampleSummary& summary);
+
+// quoted JSON string with escaped control characters
+void writeString(FILE* file, const char* text);
+
+
+#endif //ZPG_BENCH_REPORT_H
@@ -0,0 +1,46 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include "gpu_timer.h"
+
+GpuTimer::GpuTimer(size_t capacity) {
+    // software rasterizers may report a zero bit counter
+    GLint bits = 0;
+    glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &bits);
+    supported = bits > 0;
+    if (!supported)
+        return;
+
+    queries.resize(capacity);
+    glGenQueries(static_cast<GLsizei>(queries.size()), queries.data());
+}
+
+GpuTimer::~GpuTimer() {
+    if (!queries.empty())
+        glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+}
+
+void GpuTimer::begin() {
+    if (supported && used < queries.size())
+        glBeginQuery(GL_TIME_ELAPSED, queries[used]);
+}
+
+void GpuTimer::end() {
+    if (supported && used < queries.size()) {
+        glEndQuery(GL_TIME_ELAPSED);
+        used++;
+    }
+}
+
+std::vector<double> GpuTimer::collect() {
+    std::vector<double> milliseconds;
+    milliseconds.reserve(used);
+    for (size_t i = 0; i < used; i++) {
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &nanoseconds);
+        milliseconds.push_back(static_cast<double>(nanoseconds) * 1e-6);
+    }
+    used = 0;
+    return milliseconds;
+}
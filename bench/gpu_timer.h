@@ -0,0 +1,39 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_GPU_TIMER_H
+#define ZPG_GPU_TIMER_H
+
+//Include GLEW
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+//
+// GL_TIME_ELAPSED queries, one per measured frame.
+// Results are read back only in collect(), so measuring never stalls the pipeline.
+//
+class GpuTimer {
+private:
+    std::vector<GLuint> queries;
+    size_t used = 0;
+    bool supported;
+public:
+    explicit GpuTimer(size_t capacity);
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    [[nodiscard]] bool isSupported() const { return supported; }
+
+    void begin();
+    void end();
+    // elapsed milliseconds of every finished query, resets the timer
+    std::vector<double> collect();
+};
+
+
+#endif //ZPG_GPU_TIMER_H
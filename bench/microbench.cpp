@@ -0,0 +1,441 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+//
+// CPU microbenchmarks of the per-frame hot paths, running on the null GL backend (see null_gl.h).
+// Sizes and inputs are fixed, so results of two commits can be compared name by name.
+// Has to be started from the repository root, the shader sources are read from SHADERS_PATH.
+//
+// zpg_microbench [--filter substring] [--budget ms] [--gl-calls] [--output out.json]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/loaders/model_loader.h"
+#include "models/animations/centric_model.h"
+#include "models/animations/cubic_chain.h"
+#include "models/animations/linear.h"
+#include "rendering/animation_manager.h"
+#include "rendering/camera.h"
+#include "rendering/light_manager.h"
+#include "rendering/object_manager.h"
+#include "rendering/light/point_light.h"
+#include "shaders/shader_loader.h"
+#include "transform/transform_store.h"
+#include "null_gl.h"
+#include "bench_report.h"
+
+// samples taken at least, regardless of the time budget
+static constexpr int MIN_SAMPLES = 20;
+static constexpr int MAX_SAMPLES = 10000;
+static constexpr int WARMUP_RUNS = 3;
+
+// results are accumulated here, so the optimizer cannot drop the measured work
+static volatile float sink;
+
+struct Microbench {
+    std::string name;
+    // operations done by one body call, results are reported per operation
+    size_t ops = 1;
+    // untimed, runs before every body call
+    std::function<void()> setup;
+    std::function<void()> body;
+};
+
+struct MicroResult {
+    std::string name;
+    size_t ops;
+    SampleSummary ns_per_op;
+    double gl_calls_per_op;
+};
+
+struct MicrobenchOptions {
+    std::string filter;
+    double budget_ms = 250.0;
+    bool print_gl_calls = false;
+    std::string output = "zpg_microbench.json";
+};
+
+static MicroResult run(const Microbench& bench, const MicrobenchOptions& options) {
+    using clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < WARMUP_RUNS; i++) {
+        if (bench.setup)
+            bench.setup();
+        bench.body();
+    }
+
+    std::vector<double> samples;
+    uint64_t gl_calls = 0;
+    const auto deadline = clock::now() + std::chrono::duration<double, std::milli>(options.budget_ms);
+    while (samples.size() < MIN_SAMPLES || (clock::now() < deadline && samples.size() < MAX_SAMPLES)) {
+        if (bench.setup)
+            bench.setup();
+
+        NullGL::reset();
+        auto start = clock::now();
+        bench.body();
+        auto end = clock::now();
+        gl_calls += NullGL::totalCalls();
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+        samples.push_back(nanoseconds / static_cast<double>(bench.ops));
+    }
+
+    if (options.print_gl_calls) {
+        printf("%s, GL calls of the last sample:\n", bench.name.c_str());
+        NullGL::print();
+    }
+
+    double ops_total = static_cast<double>(samples.size() * bench.ops);
+    return MicroResult{bench.name, bench.ops, summarize(samples), static_cast<double>(gl_calls) / ops_total};
+}
+
+//
+// Transformations
+//
+
+// chain of transforms, every node parented to the previous one, like nested CentricComposites
+struct TransformChain {
+    std::vector<TRANSFORM_ID> nodes;
+
+    explicit TransformChain(int depth) {
+        auto& store = TransformStore::get();
+        for (int i = 0; i < depth; i++) {
+            TRANSFORM_ID node = store.create(glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+            if (!nodes.empty())
+                store.setParent(node, nodes.back());
+            nodes.push_back(node);
+        }
+    }
+
+    ~TransformChain() {
+        for (TRANSFORM_ID node: nodes) {
+            TransformStore::get().release(node);
+        }
+    }
+
+    // every node moves, like the animation steps of a CentricComposite tree
+    void touch() {
+        auto& store = TransformStore::get();
+        for (TRANSFORM_ID node: nodes) {
+            store.translate(node, glm::vec3(0.001f, 0.f, 0.f));
+        }
+    }
+};
+
+// a hundred roots with a hundred children each, like planets with their moons
+struct TransformForest {
+    std::vector<TRANSFORM_ID> roots;
+    std::vector<TRANSFORM_ID> children;
+
+    TransformForest() {
+        auto& store = TransformStore::get();
+        for (int i = 0; i < 100; i++) {
+            TRANSFORM_ID root = store.create(glm::vec3(static_cast<float>(i), 0.f, 0.f), glm::vec3(0.f, 1.f, 0.f));
+            roots.push_back(root);
+            for (int j = 0; j < 100; j++) {
+                TRANSFORM_ID child = store.create(glm::vec3(0.f, 0.f, static_cast<float>(j)), glm::vec3(0.f, 1.f, 0.f));
+                store.setParent(child, root);
+                children.push_back(child);
+            }
+        }
+        store.update();
+    }
+
+    ~TransformForest() {
+        for (TRANSFORM_ID node: children) {
+            TransformStore::get().release(node);
+        }
+        for (TRANSFORM_ID node: roots) {
+            TransformStore::get().release(node);
+        }
+    }
+};
+
+static void addTransformBenches(std::vector<Microbench>& benches) {
+    for (int depth: {4, 16, 64}) {
+        auto chain = std::make_shared<TransformChain>(depth);
+        benches.push_back({"transform.getMatrix.depth" + std::to_string(depth), 100, nullptr, [chain]() {
+            for (int i = 0; i < 100; i++) {
+                chain->touch();
+                sink = sink + TransformStore::get().getWorld(chain->nodes.back())[3][0];
+            }
+        }});
+        benches.push_back({"transform.getNormalMatrix.depth" + std::to_string(depth), 100, nullptr, [chain]() {
+            for (int i = 0; i < 100; i++) {
+                chain->touch();
+                sink = sink + TransformStore::get().getNormal(chain->nodes.back())[0][0];
+            }
+        }});
+    }
+
+    // the per frame batch pass, every root orbits so every child is recomputed too
+    auto forest = std::make_shared<TransformForest>();
+    benches.push_back({"transformStore.update.10100", 1, nullptr, [forest]() {
+        auto& store = TransformStore::get();
+        for (TRANSFORM_ID root: forest->roots) {
+            store.orbit(root, 1.f, glm::vec3(0.f));
+        }
+        store.update();
+        sink = sink + store.getWorld(forest->children.back())[3][0];
+    }});
+}
+
+//
+// Animations
+//
+
+static std::unique_ptr<CentricModelComponent> buildCentric(const Model* model, int level, int depth, int branching) {
+    auto object = std::make_unique<DrawableObject>(glm::vec3(8.f / static_cast<float>(level + 1), 0.f, 0.f),
+                                                   model, "blinn", glm::vec3(0.f, 1.f, 0.f));
+    if (level == depth)
+        return std::make_unique<CentricModelLeaf>(std::move(object));
+
+    auto composite = std::make_unique<CentricComposite>(std::move(object));
+    for (int i = 0; i < branching; i++) {
+        composite->addModel(buildCentric(model, level + 1, depth, branching));
+    }
+    return composite;
+}
+
+static void addAnimationBenches(std::vector<Microbench>& benches) {
+    const Model* sphere = ModelLoader::getInstance().loadModel("sphere");
+
+    // 1 + 4 + 16 + 64 + 256 nodes
+    std::shared_ptr<CentricModelComponent> centric = buildCentric(sphere, 0, 4, 4);
+    auto* root = dynamic_cast<CentricComposite*>(centric.get());
+    benches.push_back({"centric.bfsTraverse.341", 1, nullptr, [centric, root]() {
+        int visited = 0;
+        root->bfsTraverse([&visited](CentricModelComponent*) { visited++; });
+        sink = sink + static_cast<float>(visited);
+    }});
+    benches.push_back({"centric.stepAndMatrices.341", 1, nullptr, [centric, root]() {
+        float sum = 0.f;
+        root->bfsTraverse([](CentricModelComponent* component) { component->step(1.f); });
+        root->bfsTraverse([&sum](CentricModelComponent* component) {
+            sum += component->getDrawableObject().getModelMatrix()[3][0];
+        });
+        sink = sink + sum;
+    }});
+
+    // 1 + 4 + ... + 4096 nodes, stepped and composed on the shared thread pool (THREAD_POOL_WORKERS)
+    auto manager = std::make_shared<AnimationManager>();
+    manager->addAnimation(buildCentric(sphere, 0, 6, 4));
+    benches.push_back({"animationManager.stepAnimations.5461", 1, nullptr, [manager]() {
+        manager->stepAnimations(1.f);
+        TransformStore::get().update();
+        sink = sink + (*manager->begin())->getDrawableObject().getModelMatrix()[3][0];
+    }});
+
+    auto chain = std::make_shared<CubicChain>(std::make_unique<DrawableObject>(glm::vec3(0.f), sphere, "blinn"),
+                                              .001f, AnimationArgs::RESTART);
+    for (int i = 0; i < 8; i++) {
+        float x = static_cast<float>(i);
+        chain->addControlPoint(glm::mat3x3(glm::vec3(x, 1.f, 0.f), glm::vec3(x, 2.f, 1.f), glm::vec3(x + 1.f, 0.f, 0.f)));
+    }
+    benches.push_back({"cubicChain.step", 1000, nullptr, [chain]() {
+        for (int i = 0; i < 1000; i++) {
+            chain->step(1.f);
+        }
+        sink = sink + chain->getDrawableObject().getModelMatrix()[3][0];
+    }});
+
+    auto linear = std::make_shared<Linear>(std::make_unique<DrawableObject>(glm::vec3(0.f), sphere, "blinn"),
+                                           glm::vec3(0.f), glm::vec3(1.f, 1.f, 0.f), 10.f, .015f,
+                                           AnimationArgs::CYCLE);
+    benches.push_back({"linear.step", 1000, nullptr, [linear]() {
+        for (int i = 0; i < 1000; i++) {
+            linear->step(1.f);
+        }
+        sink = sink + linear->getDrawableObject().getModelMatrix()[3][0];
+    }});
+}
+
+//
+// Object manager
+//
+
+struct ObjectManagerFixture {
+    std::unique_ptr<ObjectManager> manager;
+    std::unique_ptr<RenderQueue> render_queue;
+};
+
+static void addObjectManagerBenches(std::vector<Microbench>& benches, const std::shared_ptr<ShaderLoader>& shader_loader) {
+    const Model* sphere = ModelLoader::getInstance().loadModel("sphere");
+    const char* shaders[] = {"phong", "blinn", "constant", "lambert"};
+
+    auto fixture = std::make_shared<ObjectManagerFixture>();
+    auto fill = [fixture, sphere, shaders](int count, int interact) {
+        fixture->render_queue = std::make_unique<RenderQueue>();
+        fixture->manager = std::make_unique<ObjectManager>();
+        for (int i = 0; i < count; i++) {
+            glm::vec3 position(static_cast<float>(i % 32) * 2.f, 0.f, static_cast<float>(i / 32) * 2.f);
+            // interactive objects are never batched, constant has no instanced variant
+            const char* shader = i < interact ? "constant" : shaders[i % 4];
+            auto object = std::make_unique<DrawableObject>(position, sphere, shader);
+            if (i < interact)
+                object->markInteract();
+            fixture->manager->addObject(std::move(object));
+        }
+    };
+
+    benches.push_back({"objectManager.preprocess.enqueue1000", 1000,
+                       [fill]() { fill(1000, 0); },
+                       [fixture, shader_loader]() {
+                           fixture->manager->preprocess(shader_loader.get(), *fixture->render_queue);
+                           // the queue applies the changes with the next depth update
+                           fixture->render_queue->updateDepth(glm::vec3(0.f));
+                       }});
+
+    benches.push_back({"objectManager.preprocess.delete100", 100,
+                       [fixture, fill, shader_loader]() {
+                           fill(1000, 100);
+                           fixture->manager->preprocess(shader_loader.get(), *fixture->render_queue);
+                           fixture->render_queue->updateDepth(glm::vec3(0.f));
+                           for (char id = 1; id <= 100; id++) {
+                               fixture->manager->deleteByInteractID(id);
+                           }
+                       },
+                       [fixture, shader_loader]() {
+                           fixture->manager->preprocess(shader_loader.get(), *fixture->render_queue);
+                           // the queue applies the changes with the next depth update
+                           fixture->render_queue->updateDepth(glm::vec3(0.f));
+                       }});
+}
+
+//
+// Lights and uniforms
+//
+
+static void addLightBenches(std::vector<Microbench>& benches) {
+    auto camera = std::make_shared<Camera>(1280, 720);
+    auto manager = std::make_shared<std::unique_ptr<LightManager>>();
+
+    auto randomLight = [](int i) {
+        float x = static_cast<float>(i % 16) * 4.f - 32.f;
+        float z = static_cast<float>(i / 16) * 4.f - 32.f;
+        return std::make_shared<PointLight>(glm::vec3(x, 2.f, z), glm::vec3(1.f), 1.f, 1.f, 0.1f, 0.01f);
+    };
+
+    benches.push_back({"lightManager.addLight.256", 256,
+                       [manager]() { *manager = std::make_unique<LightManager>(); },
+                       [manager, randomLight]() {
+                           for (int i = 0; i < 256; i++) {
+                               (*manager)->addLight(randomLight(i));
+                           }
+                       }});
+
+    // every light moved, records re-packed and the cluster grid rebuilt
+    benches.push_back({"lightManager.uploadBlock.256", 1,
+                       [manager, camera, randomLight]() {
+                           *manager = std::make_unique<LightManager>();
+                           for (int i = 0; i < 256; i++) {
+                               (*manager)->addLight(randomLight(i));
+                           }
+                           (*manager)->start(*camera);
+                           for (int i = 0; i < 256; i++) {
+                               (*manager)->markDirty(i);
+                           }
+                       },
+                       [manager, camera]() { (*manager)->uploadBlock(*camera); }});
+}
+
+static void addUniformBenches(std::vector<Microbench>& benches, const std::shared_ptr<ShaderLoader>& shader_loader) {
+    const Model* sphere = ModelLoader::getInstance().loadModel("sphere");
+    auto object = std::make_shared<DrawableObject>(glm::vec3(0.f), sphere, "phong");
+    object->assignShaderAlias(shader_loader->getShaderAlias("phong"));
+    Shader* shader = shader_loader->loadShader(object->getShaderAlias());
+    object->attach(shader);
+
+    // material and model matrix of one object, as before every non-instanced draw
+    benches.push_back({"shader.lazyPassUniforms.object", 1000, nullptr, [object, shader]() {
+        for (int i = 0; i < 1000; i++) {
+            object->notifyModel();
+            object->notifyMaterial();
+            shader->lazyPassUniforms();
+        }
+    }});
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--filter substring] [--budget ms] [--gl-calls] [--output out.json]\n", program);
+}
+
+static bool parseArguments(int argc, char** argv, MicrobenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--budget" && has_value) {
+            options.budget_ms = atof(argv[++i]);
+        } else if (arg == "--gl-calls") {
+            options.print_gl_calls = true;
+        } else if (arg == "--output" && has_value) {
+            options.output = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.budget_ms > 0.0;
+}
+
+int main(int argc, char** argv) {
+    MicrobenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    NullGL::install();
+
+    auto shader_loader = std::make_shared<ShaderLoader>();
+    shader_loader->loadShaders();
+    for (auto shader: *shader_loader) {
+        shader->initUniforms();
+    }
+
+    std::vector<Microbench> benches;
+    addTransformBenches(benches);
+    addAnimationBenches(benches);
+    addObjectManagerBenches(benches, shader_loader);
+    addLightBenches(benches);
+    addUniformBenches(benches, shader_loader);
+
+    std::vector<MicroResult> results;
+    for (const auto& bench: benches) {
+        if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos)
+            continue;
+
+        results.push_back(run(bench, options));
+        const auto& result = results.back();
+        printf("%-40s p50 %10.1f ns/op  p99 %10.1f ns/op  %6.2f GL calls/op\n",
+               result.name.c_str(), result.ns_per_op.p50, result.ns_per_op.p99, result.gl_calls_per_op);
+    }
+
+    FILE* file = fopen(options.output.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "ERROR: cannot write %s\n", options.output.c_str());
+        return EXIT_FAILURE;
+    }
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+        fprintf(file, "    {\"name\": ");
+        writeString(file, result.name.c_str());
+        fprintf(file, ", \"ops\": %zu, ", result.ops);
+        writeSummary(file, "ns_per_op", result.ns_per_op);
+        fprintf(file, ", \"gl_calls_per_op\": %.3f}%s\n", result.gl_calls_per_op, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    printf("Results written to %s\n", options.output.c_str());
+}
@@ -0,0 +1,229 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+//Include GLEW
+#include <GL/glew.h>
+
+#include <cstdio>
+#include <type_traits>
+
+#include "null_gl.h"
+
+namespace {
+    struct NullEntry {
+        const char* name;
+        uint64_t calls;
+    };
+
+    constexpr int MAX_ENTRIES = 128;
+    NullEntry entries[MAX_ENTRIES];
+    int entry_count = 0;
+    GLuint next_name = 1;
+
+    NullEntry* registerEntry(const char* name) {
+        for (int i = 0; i < entry_count; i++) {
+            if (entries[i].name == name)
+                return &entries[i];
+        }
+        if (entry_count == MAX_ENTRIES) {
+            fprintf(stderr, "NullGL: Too many entry points\n");
+            return &entries[MAX_ENTRIES - 1];
+        }
+        entries[entry_count] = {name, 0};
+        return &entries[entry_count++];
+    }
+
+    void generateNames(GLsizei count, GLuint* names) {
+        for (GLsizei i = 0; i < count; i++) {
+            names[i] = next_name++;
+        }
+    }
+
+    // stub for a GLEW function pointer, returns a value initialized result
+    template<auto& Pointer, typename Function = std::remove_reference_t<decltype(Pointer)>>
+    struct NullFunction;
+
+    template<auto& Pointer, typename R, typename... Args>
+    struct NullFunction<Pointer, R (GLAPIENTRY*)(Args...)> {
+        static inline NullEntry* entry = nullptr;
+
+        static R GLAPIENTRY call(Args...) {
+            entry->calls++;
+            if constexpr (!std::is_void_v<R>)
+                return R{};
+        }
+
+        static void install(const char* name) {
+            entry = registerEntry(name);
+            Pointer = &call;
+        }
+    };
+
+    // stubs with output parameters or meaningful results
+    NullEntry* gen_buffers;
+    NullEntry* gen_vertex_arrays;
+    NullEntry* gen_framebuffers;
+    NullEntry* gen_renderbuffers;
+    NullEntry* create_shader;
+    NullEntry* create_program;
+    NullEntry* check_framebuffer_status;
+
+    void GLAPIENTRY nullGenBuffers(GLsizei count, GLuint* names) {
+        gen_buffers->calls++;
+        generateNames(count, names);
+    }
+
+    void GLAPIENTRY nullGenVertexArrays(GLsizei count, GLuint* names) {
+        gen_vertex_arrays->calls++;
+        generateNames(count, names);
+    }
+
+    void GLAPIENTRY nullGenFramebuffers(GLsizei count, GLuint* names) {
+        gen_framebuffers->calls++;
+        generateNames(count, names);
+    }
+
+    void GLAPIENTRY nullGenRenderbuffers(GLsizei count, GLuint* names) {
+        gen_renderbuffers->calls++;
+        generateNames(count, names);
+    }
+
+    GLuint GLAPIENTRY nullCreateShader(GLenum) {
+        create_shader->calls++;
+        return next_name++;
+    }
+
+    GLuint GLAPIENTRY nullCreateProgram() {
+        create_program->calls++;
+        return next_name++;
+    }
+
+    GLenum GLAPIENTRY nullCheckFramebufferStatus(GLenum) {
+        check_framebuffer_status->calls++;
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+}
+
+#define NULL_GL_FUNCTION(function) NullFunction<__glew##function>::install("gl" #function)
+#define NULL_GL_RECORD(function) do { static NullEntry* entry = registerEntry(#function); entry->calls++; } while (0)
+
+//
+// OpenGL 1.1, exported by libGL itself instead of going through GLEW
+//
+extern "C" {
+void GLAPIENTRY glBindTexture(GLenum, GLuint) { NULL_GL_RECORD(glBindTexture); }
+void GLAPIENTRY glClear(GLbitfield) { NULL_GL_RECORD(glClear); }
+void GLAPIENTRY glDeleteTextures(GLsizei, const GLuint*) { NULL_GL_RECORD(glDeleteTextures); }
+void GLAPIENTRY glDepthFunc(GLenum) { NULL_GL_RECORD(glDepthFunc); }
+void GLAPIENTRY glDepthMask(GLboolean) { NULL_GL_RECORD(glDepthMask); }
+void GLAPIENTRY glDisable(GLenum) { NULL_GL_RECORD(glDisable); }
+void GLAPIENTRY glDrawArrays(GLenum, GLint, GLsizei) { NULL_GL_RECORD(glDrawArrays); }
+void GLAPIENTRY glDrawBuffer(GLenum) { NULL_GL_RECORD(glDrawBuffer); }
+void GLAPIENTRY glDrawElements(GLenum, GLsizei, GLenum, const void*) { NULL_GL_RECORD(glDrawElements); }
+void GLAPIENTRY glEnable(GLenum) { NULL_GL_RECORD(glEnable); }
+void GLAPIENTRY glPixelStorei(GLenum, GLint) { NULL_GL_RECORD(glPixelStorei); }
+void GLAPIENTRY glReadBuffer(GLenum) { NULL_GL_RECORD(glReadBuffer); }
+void GLAPIENTRY glReadPixels(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*) { NULL_GL_RECORD(glReadPixels); }
+void GLAPIENTRY glStencilFunc(GLenum, GLint, GLuint) { NULL_GL_RECORD(glStencilFunc); }
+void GLAPIENTRY glStencilOp(GLenum, GLenum, GLenum) { NULL_GL_RECORD(glStencilOp); }
+void GLAPIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) { NULL_GL_RECORD(glTexImage2D); }
+void GLAPIENTRY glTexParameteri(GLenum, GLenum, GLint) { NULL_GL_RECORD(glTexParameteri); }
+void GLAPIENTRY glViewport(GLint, GLint, GLsizei, GLsizei) { NULL_GL_RECORD(glViewport); }
+
+void GLAPIENTRY glGenTextures(GLsizei count, GLuint* names) {
+    NULL_GL_RECORD(glGenTextures);
+    generateNames(count, names);
+}
+
+const GLubyte* GLAPIENTRY glGetString(GLenum) {
+    NULL_GL_RECORD(glGetString);
+    return reinterpret_cast<const GLubyte*>("null");
+}
+}
+
+void NullGL::install() {
+    NULL_GL_FUNCTION(ActiveTexture);
+    NULL_GL_FUNCTION(AttachShader);
+    NULL_GL_FUNCTION(BindBuffer);
+    NULL_GL_FUNCTION(BindBufferBase);
+    NULL_GL_FUNCTION(BindFramebuffer);
+    NULL_GL_FUNCTION(BindRenderbuffer);
+    NULL_GL_FUNCTION(BindVertexArray);
+    NULL_GL_FUNCTION(BufferData);
+    NULL_GL_FUNCTION(BufferSubData);
+    NULL_GL_FUNCTION(CompileShader);
+    NULL_GL_FUNCTION(CopyBufferSubData);
+    NULL_GL_FUNCTION(DeleteBuffers);
+    NULL_GL_FUNCTION(DeleteFramebuffers);
+    NULL_GL_FUNCTION(DeleteProgram);
+    NULL_GL_FUNCTION(DeleteRenderbuffers);
+    NULL_GL_FUNCTION(DeleteShader);
+    NULL_GL_FUNCTION(DeleteVertexArrays);
+    NULL_GL_FUNCTION(DrawArraysInstanced);
+    NULL_GL_FUNCTION(DrawElementsInstanced);
+    NULL_GL_FUNCTION(EnableVertexAttribArray);
+    NULL_GL_FUNCTION(FramebufferRenderbuffer);
+    NULL_GL_FUNCTION(GetActiveUniform);
+    NULL_GL_FUNCTION(GetActiveUniformBlockName);
+    NULL_GL_FUNCTION(GetBufferSubData);
+    NULL_GL_FUNCTION(GetProgramiv);
+    NULL_GL_FUNCTION(GetUniformBlockIndex);
+    NULL_GL_FUNCTION(GetUniformLocation);
+    NULL_GL_FUNCTION(LinkProgram);
+    NULL_GL_FUNCTION(MultiDrawArraysIndirect);
+    NULL_GL_FUNCTION(MultiDrawElementsIndirect);
+    NULL_GL_FUNCTION(RenderbufferStorage);
+    NULL_GL_FUNCTION(ShaderSource);
+    NULL_GL_FUNCTION(TexBuffer);
+    NULL_GL_FUNCTION(Uniform1f);
+    NULL_GL_FUNCTION(Uniform1i);
+    NULL_GL_FUNCTION(Uniform3fv);
+    NULL_GL_FUNCTION(Uniform4fv);
+    NULL_GL_FUNCTION(UniformBlockBinding);
+    NULL_GL_FUNCTION(UniformMatrix3fv);
+    NULL_GL_FUNCTION(UniformMatrix4fv);
+    NULL_GL_FUNCTION(UseProgram);
+    NULL_GL_FUNCTION(VertexAttribDivisor);
+    NULL_GL_FUNCTION(VertexAttribIPointer);
+    NULL_GL_FUNCTION(VertexAttribPointer);
+
+    gen_buffers = registerEntry("glGenBuffers");
+    __glewGenBuffers = nullGenBuffers;
+    gen_vertex_arrays = registerEntry("glGenVertexArrays");
+    __glewGenVertexArrays = nullGenVertexArrays;
+    gen_framebuffers = registerEntry("glGenFramebuffers");
+    __glewGenFramebuffers = nullGenFramebuffers;
+    gen_renderbuffers = registerEntry("glGenRenderbuffers");
+    __glewGenRenderbuffers = nullGenRenderbuffers;
+    create_shader = registerEntry("glCreateShader");
+    __glewCreateShader = nullCreateShader;
+    create_program = registerEntry("glCreateProgram");
+    __glewCreateProgram = nullCreateProgram;
+    check_framebuffer_status = registerEntry("glCheckFramebufferStatus");
+    __glewCheckFramebufferStatus = nullCheckFramebufferStatus;
+
+    // take the multi draw indirect path as a GL 4.3 context would
+    __GLEW_VERSION_4_3 = GL_TRUE;
+}
+
+uint64_t NullGL::totalCalls() {
+    uint64_t total = 0;
+    for (int i = 0; i < entry_count; i++) {
+        total += entries[i].calls;
+    }
+    return total;
+}
+
+void NullGL::reset() {
+    for (int i = 0; i < entry_count; i++) {
+        entries[i].calls = 0;
+    }
+}
+
+void NullGL::print() {
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].calls > 0)
+            printf("%-28s %llu\n", entries[i].name, static_cast<unsigned long long>(entries[i].calls));
+    }
+}
@@ -0,0 +1,31 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_NULL_GL_H
+#define ZPG_NULL_GL_H
+
+#include <cstdint>
+
+//
+// No-op OpenGL backend for CPU microbenchmarks, no context or GPU is needed.
+// GLEW function pointers used by the renderer are pointed at recording stubs, the OpenGL 1.1 entry points
+// are defined in null_gl.cpp and take precedence over libGL. Every call is only counted,
+// glGen* and glCreate* hand out increasing names.
+// Entry points not listed in install() stay null, a new GL call in the renderer has to be added there.
+//
+class NullGL {
+public:
+    NullGL() = delete;
+
+    static void install();
+
+    // calls of all entry points since the last reset
+    [[nodiscard]] static uint64_t totalCalls();
+    static void reset();
+    // per entry point call counts since the last reset
+    static void print();
+};
+
+
+#endif //ZPG_NULL_GL_H
@@ -0,0 +1,256 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+//
+// Deterministic scene benchmark.
+// Every SceneLoader scene is stepped with a fixed time step while the camera follows a scripted path,
+// CPU (submission) and GPU (GL_TIME_ELAPSED) frame times are summarized as JSON.
+//
+// zpg_bench [--headless] [--size WxH] [--frames N] [--warmup N] [--scene N] [--path camera.txt] [--output out.json]
+//           [--stress key=value,...]
+//
+// --stress benchmarks only the generated stress scene, keys are the StressSceneConfig fields:
+// seed, extent, objects, textured, points, spots, directionals, linear, bezier, chain, centric, depth, branching
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/application.h"
+#include "rendering/camera_path.h"
+#include "util/render_stats.h"
+#include "gpu_timer.h"
+#include "bench_report.h"
+
+// scenes scatter objects with rand(), reseed before every load
+static constexpr unsigned BENCH_SEED = 0;
+// default path, an orbit around the origin
+static constexpr float BENCH_ORBIT_RADIUS = 10.f;
+static constexpr float BENCH_ORBIT_HEIGHT = 3.f;
+
+struct BenchOptions {
+    int width = 1280;
+    int height = 720;
+    int frames = 300;
+    int warmup = 30;
+    // -1 runs all scenes
+    int scene = -1;
+    bool headless = false;
+    std::string path;
+    std::string output = "zpg_bench.json";
+    bool stress = false;
+    StressSceneConfig stress_config;
+};
+
+struct SceneResult {
+    int scene;
+    SampleSummary cpu_ms;
+    SampleSummary gpu_ms;
+    // per measured frame averages
+    double draw_calls = 0;
+    double program_switches = 0;
+    double uniform_uploads = 0;
+    double texture_binds = 0;
+};
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--headless] [--size WxH] [--frames N] [--warmup N] [--scene N] "
+                    "[--path camera.txt] [--output out.json] [--stress key=value,...]\n", program);
+}
+
+static bool parseStressConfig(const std::string& spec, StressSceneConfig& config) {
+    std::istringstream stream(spec);
+    std::string pair;
+    while (std::getline(stream, pair, ',')) {
+        size_t separator = pair.find('=');
+        if (separator == std::string::npos)
+            return false;
+        std::string key = pair.substr(0, separator);
+        const char* value = pair.c_str() + separator + 1;
+
+        if (key == "seed") config.seed = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        else if (key == "extent") config.extent = strtof(value, nullptr);
+        else if (key == "objects") config.static_objects = atoi(value);
+        else if (key == "textured") config.textured_fraction = strtof(value, nullptr);
+        else if (key == "points") config.point_lights = atoi(value);
+        else if (key == "spots") config.spotlights = atoi(value);
+        else if (key == "directionals") config.directional_lights = atoi(value);
+        else if (key == "linear") config.linear_animations = atoi(value);
+        else if (key == "bezier") config.bezier_animations = atoi(value);
+        else if (key == "chain") config.chain_animations = atoi(value);
+        else if (key == "centric") config.centric_animations = atoi(value);
+        else if (key == "depth") config.centric_depth = atoi(value);
+        else if (key == "branching") config.centric_branching = atoi(value);
+        else return false;
+    }
+    return true;
+}
+
+static bool parseArguments(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--size" && has_value) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2)
+                return false;
+        } else if (arg == "--frames" && has_value) {
+            options.frames = atoi(argv[++i]);
+        } else if (arg == "--warmup" && has_value) {
+            options.warmup = atoi(argv[++i]);
+        } else if (arg == "--scene" && has_value) {
+            options.scene = atoi(argv[++i]);
+        } else if (arg == "--path" && has_value) {
+            options.path = argv[++i];
+        } else if (arg == "--output" && has_value) {
+            options.output = argv[++i];
+        } else if (arg == "--stress" && has_value) {
+            options.stress = true;
+            if (!parseStressConfig(argv[++i], options.stress_config))
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return options.width > 0 && options.height > 0 && options.frames > 0 && options.warmup >= 0;
+}
+
+// measures the scene currently loaded by the application
+static SceneResult benchScene(Application& app, int scene_id, const CameraPath& path, const BenchOptions& options) {
+    Scene& scene = app.getScene();
+    Camera& camera = scene.getCamera();
+
+    SceneResult result;
+    result.scene = scene_id;
+    GpuTimer gpu_timer(options.frames);
+    std::vector<double> cpu_samples;
+    cpu_samples.reserve(options.frames);
+
+    const float delta_time = HEADLESS_FRAME_TIME * FRAME_TIME_MULTIPLIER;
+    for (int i = -options.warmup; i < options.frames; i++) {
+        const bool measured = i >= 0;
+        // warmup frames stay at the start of the path
+        float progress = options.frames > 1 ? static_cast<float>(std::max(i, 0)) / (options.frames - 1) : 0.f;
+        glm::vec3 position, target;
+        path.sample(progress, position, target);
+        camera.lookAt(position, target);
+
+        if (measured)
+            gpu_timer.begin();
+        auto start = std::chrono::steady_clock::now();
+        scene.frame(delta_time);
+        auto end = std::chrono::steady_clock::now();
+        if (measured)
+            gpu_timer.end();
+
+        // a swap would throttle the same way, frames must not queue up
+        glFinish();
+        RenderStats::endFrame();
+        if (!options.headless)
+            glfwPollEvents();
+
+        if (!measured)
+            continue;
+        cpu_samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        const auto& counters = RenderStats::lastFrame();
+        result.draw_calls += counters.draw_calls;
+        result.program_switches += counters.program_switches;
+        result.uniform_uploads += counters.uniform_uploads;
+        result.texture_binds += counters.texture_binds;
+    }
+
+    result.cpu_ms = summarize(cpu_samples);
+    result.gpu_ms = summarize(gpu_timer.collect());
+    result.draw_calls /= options.frames;
+    result.program_switches /= options.frames;
+    result.uniform_uploads /= options.frames;
+    result.texture_binds /= options.frames;
+    return result;
+}
+
+static void writeReport(FILE* file, const BenchOptions& options, const std::vector<SceneResult>& results) {
+    fprintf(file, "{\n  \"renderer\": ");
+    writeString(file, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    fprintf(file, ",\n  \"version\": ");
+    writeString(file, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    fprintf(file, ",\n  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %d,\n  \"warmup\": %d,\n  \"time_step\": %.6f,\n",
+            options.width, options.height, options.frames, options.warmup, HEADLESS_FRAME_TIME);
+    fprintf(file, "  \"path\": ");
+    writeString(file, options.path.empty() ? "orbit" : options.path.c_str());
+    if (options.stress) {
+        const auto& config = options.stress_config;
+        fprintf(file, ",\n  \"stress\": {\"seed\": %u, \"extent\": %.1f, \"objects\": %d, \"textured\": %.3f, "
+                      "\"points\": %d, \"spots\": %d, \"directionals\": %d, \"linear\": %d, \"bezier\": %d, "
+                      "\"chain\": %d, \"centric\": %d, \"depth\": %d, \"branching\": %d}",
+                config.seed, config.extent, config.static_objects, config.textured_fraction,
+                config.point_lights, config.spotlights, config.directional_lights,
+                config.linear_animations, config.bezier_animations, config.chain_animations,
+                config.centric_animations, config.centric_depth, config.centric_branching);
+    }
+    fprintf(file, ",\n  \"scenes\": [\n");
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+        fprintf(file, "    {\"scene\": %d, ", result.scene);
+        writeSummary(file, "cpu_ms", result.cpu_ms);
+        fprintf(file, ", ");
+        writeSummary(file, "gpu_ms", result.gpu_ms);
+        fprintf(file, ", \"draw_calls\": %.1f, \"program_switches\": %.1f, \"uniform_uploads\": %.1f, \"texture_binds\": %.1f}%s\n",
+                result.draw_calls, result.program_switches, result.uniform_uploads, result.texture_binds,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    CameraPath path = options.path.empty()
+                      ? CameraPath::orbit(glm::vec3(0.f), BENCH_ORBIT_RADIUS, BENCH_ORBIT_HEIGHT)
+                      : CameraPath::load(options.path);
+
+    LaunchOptions launch;
+    launch.headless = options.headless;
+    launch.scene = options.scene < 0 ? 0 : options.scene;
+    // measured frames have to draw the whole scene
+    launch.async_loading = false;
+    Application app(options.width, options.height, "ZPG - benchmark", launch);
+    app.init();
+    Application::info();
+
+    std::vector<SceneResult> results;
+    if (options.stress) {
+        printf("Benchmarking the stress scene\n");
+        app.loadStressScene(options.stress_config);
+        results.push_back(benchScene(app, SceneLoader::STRESS_SCENE_ID, path, options));
+    } else {
+        int first = options.scene < 0 ? 0 : options.scene;
+        int last = options.scene < 0 ? SceneLoader::SCENE_COUNT - 1 : options.scene;
+        for (int scene_id = first; scene_id <= last; scene_id++) {
+            printf("Benchmarking scene %d\n", scene_id);
+            srand(BENCH_SEED);
+            app.loadScene(scene_id);
+            results.push_back(benchScene(app, scene_id, path, options));
+        }
+    }
+
+    FILE* file = fopen(options.output.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "ERROR: cannot write %s\n", options.output.c_str());
+        return EXIT_FAILURE;
+    }
+    writeReport(file, options, results);
+    fclose(file);
+    printf("Benchmark written to %s\n", options.output.c_str());
+}
@@ -0,0 +1,44 @@
+#version 330
+layout(location=0) in vec3 vec_position;
+layout(location=1) in vec3 vec_normal;
+
+// per-instance data, see InstanceBatch::upload for the layout
+const int INSTANCE_TEXELS = 10;
+uniform samplerBuffer instance_sampler;
+
+// shared by all programs, see CameraBlock in camera.h
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+    mat4 projection_matrix;
+    mat4 view_projection_matrix;
+    vec4 camera_position;
+};
+
+
+out vec4 ex_world_position;
+out vec3 ex_world_normal;
+out vec3 ex_view_direction;
+
+flat out vec3 ex_ambient;
+flat out vec3 ex_diffuse;
+flat out vec4 ex_specular;
+
+void main(void) {
+    int base = gl_InstanceID * INSTANCE_TEXELS;
+    mat4 model_matrix = mat4(texelFetch(instance_sampler, base + 0),
+                             texelFetch(instance_sampler, base + 1),
+                             texelFetch(instance_sampler, base + 2),
+                             texelFetch(instance_sampler, base + 3));
+    mat3 normal_matrix = mat3(texelFetch(instance_sampler, base + 4).xyz,
+                              texelFetch(instance_sampler, base + 5).xyz,
+                              texelFetch(instance_sampler, base + 6).xyz);
+
+    ex_world_position = model_matrix * vec4(vec_position, 1.0f);
+    gl_Position = view_projection_matrix * ex_world_position;
+    ex_world_normal = normal_matrix * vec_normal;
+    ex_view_direction = camera_position.xyz - ex_world_position.xyz;
+
+    ex_ambient = texelFetch(instance_sampler, base + 7).xyz;
+    ex_diffuse = texelFetch(instance_sampler, base + 8).xyz;
+    ex_specular = texelFetch(instance_sampler, base + 9);
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#version 430
+
+flat in vec3 ex_ambient;
+
+out vec4 out_color;
+
+void main () {
+    out_color = vec4(ex_ambient, 1.0);
+}
\ No newline at end of file
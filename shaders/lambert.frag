@@ -4,10 +4,8 @@ in vec4 ex_world_position;
 in vec3 ex_world_normal;
 in vec3 ex_view_direction;
 
-// see const_light.h for the definitions of these constants
-const int P_MAX_LIGHTS = 10;
+// see DIRECTIONAL_CONFIG in const_lights.h
 const int D_MAX_LIGHTS = 5;
-const int S_MAX_LIGHTS = 5;
 
 struct Material {
     vec3 ambient;
@@ -45,14 +43,64 @@ struct SpotLight {
 
 uniform Material material;
 
-uniform PointLight point_lights[P_MAX_LIGHTS];
-uniform int point_lights_count;
+// cluster grid size, see CLUSTER_GRID_* in const.h
+const int CLUSTER_X = 16;
+const int CLUSTER_Y = 9;
+const int CLUSTER_Z = 24;
 
-uniform DirectionalLight directional_lights[D_MAX_LIGHTS];
-uniform int directional_lights_count;
+struct DirectionalLightData {
+    vec4 direction;
+    vec4 color; // rgb color, a intensity
+};
+
+// packed by LightManager, see light_block.h for the C++ side of the layout
+layout(std140) uniform Lights {
+    DirectionalLightData directional_lights[D_MAX_LIGHTS];
+    ivec4 light_counts; // point, directional, spot, first spotlight texel
+    vec4 cluster_depth; // near, far, slice scale, slice bias
+    vec4 cluster_tile; // tile width, tile height in pixels
+};
 
-uniform SpotLight spotlights[S_MAX_LIGHTS];
-uniform int spotlights_count;
+// point light records (3 texels) followed by spotlight records (4 texels)
+uniform samplerBuffer light_sampler;
+// per cluster first light index, point light count and spotlight count
+uniform usamplerBuffer cluster_sampler;
+uniform usamplerBuffer light_index_sampler;
+
+PointLight getPointLight(int i) {
+    int texel = i * 3;
+    vec4 position = texelFetch(light_sampler, texel);
+    vec4 color = texelFetch(light_sampler, texel + 1);
+    vec4 attenuation = texelFetch(light_sampler, texel + 2);
+    return PointLight(position.xyz, color.rgb, color.a, attenuation.x, attenuation.y, attenuation.z);
+}
+
+DirectionalLight getDirectionalLight(int i) {
+    DirectionalLightData data = directional_lights[i];
+    return DirectionalLight(data.direction.xyz, data.color.rgb, data.color.a);
+}
+
+SpotLight getSpotLight(int i) {
+    int texel = light_counts.w + i * 4;
+    vec4 position = texelFetch(light_sampler, texel);
+    vec4 direction = texelFetch(light_sampler, texel + 1);
+    vec4 color = texelFetch(light_sampler, texel + 2);
+    vec4 attenuation = texelFetch(light_sampler, texel + 3);
+    return SpotLight(position.xyz, direction.xyz, color.rgb, color.a,
+                     attenuation.x, attenuation.y, attenuation.z, position.w, direction.w);
+}
+
+// cluster of the current fragment, depth is sliced exponentially between the near and far plane
+uvec4 getCluster() {
+    float near_plane = cluster_depth.x;
+    float far_plane = cluster_depth.y;
+    float ndc_depth = gl_FragCoord.z * 2.0 - 1.0;
+    float view_depth = 2.0 * near_plane * far_plane / (far_plane + near_plane - ndc_depth * (far_plane - near_plane));
+    int slice = int(max(log(view_depth) * cluster_depth.z + cluster_depth.w, 0.0));
+    ivec3 cell = min(ivec3(ivec2(gl_FragCoord.xy / cluster_tile.xy), slice),
+                     ivec3(CLUSTER_X - 1, CLUSTER_Y - 1, CLUSTER_Z - 1));
+    return texelFetch(cluster_sampler, cell.x + CLUSTER_X * (cell.y + CLUSTER_Y * cell.z));
+}
 
 out vec4 out_color;
 
@@ -98,17 +146,23 @@ void main(void) {
     vec3 world_normal_norm = normalize(ex_world_normal);
 
     vec3 color_sum = vec3(0.0);
-    // Point lights
-    for(int i = 0; i < point_lights_count; ++i) {
-        color_sum += calcPointLight(point_lights[i], world_normal_norm, ex_world_position.xyz);
+    uvec4 cluster = getCluster();
+    int first_light = int(cluster.x);
+
+    // Point lights touching this cluster
+    for(int i = 0; i < int(cluster.y); ++i) {
+        int light = int(texelFetch(light_index_sampler, first_light + i).r);
+        color_sum += calcPointLight(getPointLight(light), world_normal_norm, ex_world_position.xyz);
     }
     // Directional lights
-    for(int i = 0; i < directional_lights_count; ++i) {
-        color_sum += calcDirectionalLight(directional_lights[i], world_normal_norm);
+    for(int i = 0; i < light_counts.y; ++i) {
+        color_sum += calcDirectionalLight(getDirectionalLight(i), world_normal_norm);
     }
-    // Spotlights
-    for(int i = 0; i < spotlights_count; ++i) {
-        color_sum += calcSpotLight(spotlights[i], world_normal_norm, ex_world_position.xyz);
+    // Spotlights touching this cluster, listed after the point lights
+    first_light += int(cluster.y);
+    for(int i = 0; i < int(cluster.z); ++i) {
+        int light = int(texelFetch(light_index_sampler, first_light + i).r);
+        color_sum += calcSpotLight(getSpotLight(light), world_normal_norm, ex_world_position.xyz);
     }
 
     out_color = vec4(material.ambient + color_sum, 1.0);
@@ -0,0 +1,174 @@
+#version 430
+
+in vec4 ex_world_position;
+in vec3 ex_world_normal;
+in vec3 ex_view_direction;
+flat in vec3 ex_ambient;
+flat in vec3 ex_diffuse;
+
+// see DIRECTIONAL_CONFIG in const_lights.h
+const int D_MAX_LIGHTS = 5;
+
+struct Material {
+    vec3 ambient;
+    vec3 diffuse;
+    // vec3 specular; --> Not used in this shader.
+    // float shininess; --> Not used in this shader.
+};
+
+struct PointLight {
+    vec3 position;
+    vec3 color;
+    float intensity;
+    float constant;
+    float linear;
+    float quadratic;
+};
+
+struct DirectionalLight {
+    vec3 direction;
+    vec3 color;
+    float intensity;
+};
+
+struct SpotLight {
+    vec3 position;
+    vec3 direction;
+    vec3 color;
+    float intensity;
+    float constant;
+    float linear;
+    float quadratic;
+    float cutoff;
+    float outer_cutoff;
+};
+
+// filled per draw in main
+Material material;
+
+// cluster grid size, see CLUSTER_GRID_* in const.h
+const int CLUSTER_X = 16;
+const int CLUSTER_Y = 9;
+const int CLUSTER_Z = 24;
+
+struct DirectionalLightData {
+    vec4 direction;
+    vec4 color; // rgb color, a intensity
+};
+
+// packed by LightManager, see light_block.h for the C++ side of the layout
+layout(std140) uniform Lights {
+    DirectionalLightData directional_lights[D_MAX_LIGHTS];
+    ivec4 light_counts; // point, directional, spot, first spotlight texel
+    vec4 cluster_depth; // near, far, slice scale, slice bias
+    vec4 cluster_tile; // tile width, tile height in pixels
+};
+
+// point light records (3 texels) followed by spotlight records (4 texels)
+uniform samplerBuffer light_sampler;
+// per cluster first light index, point light count and spotlight count
+uniform usamplerBuffer cluster_sampler;
+uniform usamplerBuffer light_index_sampler;
+
+PointLight getPointLight(int i) {
+    int texel = i * 3;
+    vec4 position = texelFetch(light_sampler, texel);
+    vec4 color = texelFetch(light_sampler, texel + 1);
+    vec4 attenuation = texelFetch(light_sampler, texel + 2);
+    return PointLight(position.xyz, color.rgb, color.a, attenuation.x, attenuation.y, attenuation.z);
+}
+
+DirectionalLight getDirectionalLight(int i) {
+    DirectionalLightData data = directional_lights[i];
+    return DirectionalLight(data.direction.xyz, data.color.rgb, data.color.a);
+}
+
+SpotLight getSpotLight(int i) {
+    int texel = light_counts.w + i * 4;
+    vec4 position = texelFetch(light_sampler, texel);
+    vec4 direction = texelFetch(light_sampler, texel + 1);
+    vec4 color = texelFetch(light_sampler, texel + 2);
+    vec4 attenuation = texelFetch(light_sampler, texel + 3);
+    return SpotLight(position.xyz, direction.xyz, color.rgb, color.a,
+                     attenuation.x, attenuation.y, attenuation.z, position.w, direction.w);
+}
+
+// cluster of the current fragment, depth is sliced exponentially between the near and far plane
+uvec4 getCluster() {
+    float near_plane = cluster_depth.x;
+    float far_plane = cluster_depth.y;
+    float ndc_depth = gl_FragCoord.z * 2.0 - 1.0;
+    float view_depth = 2.0 * near_plane * far_plane / (far_plane + near_plane - ndc_depth * (far_plane - near_plane));
+    int slice = int(max(log(view_depth) * cluster_depth.z + cluster_depth.w, 0.0));
+    ivec3 cell = min(ivec3(ivec2(gl_FragCoord.xy / cluster_tile.xy), slice),
+                     ivec3(CLUSTER_X - 1, CLUSTER_Y - 1, CLUSTER_Z - 1));
+    return texelFetch(cluster_sampler, cell.x + CLUSTER_X * (cell.y + CLUSTER_Y * cell.z));
+}
+
+out vec4 out_color;
+
+vec3 calcPointLight(PointLight light, vec3 normal, vec3 frag_pos_world) {
+    vec3 light_direction_n = normalize(light.position - frag_pos_world);
+    float diff = dot(light_direction_n, normal);
+
+    if (diff > 0.0) {
+        float dist = length(light.position - frag_pos_world);
+        float attenuation = 1.0 / (light.constant + light.linear * dist + light.quadratic * dist * dist);
+
+        return diff * material.diffuse * light.intensity * light.color * attenuation;
+    } else {
+        return vec3(0.0);
+    }
+}
+
+vec3 calcDirectionalLight(DirectionalLight light, vec3 normal) {
+    vec3 light_direction_n = normalize(-light.direction);
+    float diff = max(dot(normal, light_direction_n), 0.0);
+    return diff * material.diffuse * light.intensity * light.color;
+}
+
+vec3 calcSpotLight(SpotLight light, vec3 normal, vec3 frag_pos_world) {
+    vec3 light_direction_n = normalize(light.position - frag_pos_world);
+    vec3 spotlight_direction_n = normalize(-light.direction);
+    float theta = dot(light_direction_n, spotlight_direction_n);
+    float epsilon = light.cutoff - light.outer_cutoff;
+    float intensity = clamp((theta - light.outer_cutoff) / epsilon, 0.0, 1.0);
+
+    if (intensity > 0) {
+        float diff = max(dot(normal, light_direction_n), 0.0);
+        if (diff > 0.0) {
+            float dist = length(light.position - frag_pos_world);
+            float attenuation = 1.0 / (light.constant + light.linear * dist + light.quadratic * dist * dist);
+            return diff * material.diffuse * light.intensity * light.color * attenuation * intensity;
+        }
+    }
+    return vec3(0.0);
+}
+
+void main(void) {
+    material = Material(ex_ambient, ex_diffuse);
+
+    vec3 world_normal_norm = normalize(ex_world_normal);
+
+    vec3 color_sum = vec3(0.0);
+    uvec4 cluster = getCluster();
+    int first_light = int(cluster.x);
+
+    // Point lights touching this cluster
+    for(int i = 0; i < int(cluster.y); ++i) {
+        int light = int(texelFetch(light_index_sampler, first_light + i).r);
+        color_sum += calcPointLight(getPointLight(light), world_normal_norm, ex_world_position.xyz);
+    }
+    // Directional lights
+    for(int i = 0; i < light_counts.y; ++i) {
+        color_sum += calcDirectionalLight(getDirectionalLight(i), world_normal_norm);
+    }
+    // Spotlights touching this cluster, listed after the point lights
+    first_light += int(cluster.y);
+    for(int i = 0; i < int(cluster.z); ++i) {
+        int light = int(texelFetch(light_index_sampler, first_light + i).r);
+        color_sum += calcSpotLight(getSpotLight(light), world_normal_norm, ex_world_position.xyz);
+    }
+
+    out_color = vec4(material.ambient + color_sum, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#version 330
+layout(location=0) in vec3 vec_position;
+layout(location=1) in vec3 vec_normal;
+
+// per-instance orbit parameters, see OrbitalInstanced::upload for the layout
+const int INSTANCE_TEXELS = 2;
+const int MAX_ORBIT_DEPTH = 4;
+uniform samplerBuffer instance_sampler;
+uniform float orbit_time;
+
+uniform mat4 model_matrix; // orbit center
+
+// shared by all programs, see CameraBlock in camera.h
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+    mat4 projection_matrix;
+    mat4 view_projection_matrix;
+    vec4 camera_position;
+};
+
+// same rotation as RotationPoint around the y axis, angles in degrees
+vec3 orbitOffset(vec4 orbit, float height) {
+    float angle = radians(orbit.y + orbit.z * orbit_time);
+    return vec3(orbit.x * cos(angle), height, -orbit.x * sin(angle));
+}
+
+void main () {
+    int base = gl_InstanceID * INSTANCE_TEXELS;
+    vec4 orbit = texelFetch(instance_sampler, base);
+    vec4 link = texelFetch(instance_sampler, base + 1);
+    vec3 center = orbitOffset(orbit, link.x);
+
+    // parents orbit the center too, follow the chain
+    int parent = int(link.y);
+    for (int depth = 0; depth < MAX_ORBIT_DEPTH && parent >= 0; ++depth) {
+        vec4 parent_orbit = texelFetch(instance_sampler, parent * INSTANCE_TEXELS);
+        vec4 parent_link = texelFetch(instance_sampler, parent * INSTANCE_TEXELS + 1);
+        center += orbitOffset(parent_orbit, parent_link.x);
+        parent = int(parent_link.y);
+    }
+
+    gl_Position = view_projection_matrix * (model_matrix * vec4(center + vec_position * orbit.w, 1.0));
+}
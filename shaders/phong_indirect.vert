@@ -0,0 +1,51 @@
+#version 430
+layout(location=0) in vec3 vec_position;
+layout(location=1) in vec3 vec_normal;
+// index into draws, set by the base instance of the indirect command, see VertexArena
+layout(location=3) in uint draw_id;
+
+// per-draw data, see IndirectDrawData in indirect_renderer.h
+struct DrawData {
+    mat4 model_matrix;
+    mat3 normal_matrix;
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular; // w shininess
+};
+
+// binding is DRAW_DATA_STORAGE_BINDING in const.h
+layout(std430, binding = 0) readonly buffer Draws {
+    DrawData draws[];
+};
+
+// shared by all programs, see CameraBlock in camera.h
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+    mat4 projection_matrix;
+    mat4 view_projection_matrix;
+    vec4 camera_position;
+};
+
+
+out vec4 ex_world_position;
+out vec3 ex_world_normal;
+out vec3 ex_view_direction;
+
+flat out vec3 ex_ambient;
+flat out vec3 ex_diffuse;
+flat out vec4 ex_specular;
+
+void main(void) {
+    DrawData data = draws[draw_id];
+    mat4 model_matrix = data.model_matrix;
+    mat3 normal_matrix = data.normal_matrix;
+
+    ex_world_position = model_matrix * vec4(vec_position, 1.0f);
+    gl_Position = view_projection_matrix * ex_world_position;
+    ex_world_normal = normal_matrix * vec_normal;
+    ex_view_direction = camera_position.xyz - ex_world_position.xyz;
+
+    ex_ambient = data.ambient.xyz;
+    ex_diffuse = data.diffuse.xyz;
+    ex_specular = data.specular;
+}
\ No newline at end of file
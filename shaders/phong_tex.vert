@@ -4,10 +4,15 @@ layout(location=1) in vec3 vec_normal;
 layout(location=2) in vec2 vec_texcoord;
 
 uniform mat4 model_matrix;
-uniform mat4 view_matrix;
-uniform mat4 projection_matrix;
 uniform mat3 normal_matrix; //(M-1)T
-uniform vec3 camera_position;
+
+// shared by all programs, see CameraBlock in camera.h
+layout(std140) uniform Camera {
+    mat4 view_matrix;
+    mat4 projection_matrix;
+    mat4 view_projection_matrix;
+    vec4 camera_position;
+};
 
 out vec4 ex_world_position;
 out vec3 ex_world_normal;
@@ -15,9 +20,9 @@ out vec3 ex_view_direction;
 out vec2 ex_tex_coord;
 
 void main(void) {
-    gl_Position = (projection_matrix * view_matrix * model_matrix) * vec4(vec_position, 1.0f);
     ex_world_position = model_matrix * vec4(vec_position, 1.0f);
+    gl_Position = view_projection_matrix * ex_world_position;
     ex_world_normal = normal_matrix * vec_normal;
-    ex_view_direction = camera_position - ex_world_position.xyz;
+    ex_view_direction = camera_position.xyz - ex_world_position.xyz;
     ex_tex_coord = vec_texcoord;
 }
\ No newline at end of file
@@ -9,13 +9,21 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <ctime>
+#include <stdexcept>
 #include "application.h"
+#include "loaders/async_loader.h"
+#include "../util/profiler.h"
+#include "../util/render_stats.h"
 
-Application::Application(const int width, const int height, const char* title) : width(width), height(height),
-                                                                                 title(title), ratio(width / height) { }
+Application::Application(const int width, const int height, const char* title, LaunchOptions options) :
+        options(std::move(options)), width(width), height(height), title(title), ratio(width / height) {
+    current_scene_id = this->options.scene;
+}
 
 Application::~Application() {
-    glfwDestroyWindow(window);
+    if (window != nullptr)
+        glfwDestroyWindow(window);
     glfwTerminate();
 }
 
@@ -31,12 +39,123 @@ void Application::info() {
 }
 
 void Application::init() {
+    initInput();
+    if (options.headless)
+        initHeadless();
+    else
+        initWindow();
+    initRenderContext();
+
+    ratio = static_cast<float>(width) / static_cast<float>(height);
+    glViewport(0, 0, width, height);
+
+    /*
+     * Buffer settings
+     *
+     * Z-buffer */
+    glDepthMask(GL_TRUE);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+
+    // Stencil buffer
+    glEnable(GL_STENCIL_TEST);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+
+    if (ENABLE_CULL_FACE)
+        glEnable(GL_CULL_FACE);
+
+    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+    AsyncLoader::getInstance().setEnabled(options.async_loading && !options.headless && input == nullptr);
+
+    shader_loader = std::make_shared<ShaderLoader>();
+    shader_loader->loadShaders();
+
+    // init shader uniform locations
+    for (auto shader: *this->shader_loader) {
+        shader->initUniforms();
+    }
+
+    loadScene(current_scene_id);
+}
+
+void Application::loadScene(int scene_id) {
+    current_scene_id = scene_id;
+    // scenes scatter objects with rand(), a replay has to start from the recorded layout
+    if (input != nullptr)
+        srand(input->getHeader().seed);
+    scene = SceneLoader::loadScene(&current_scene_id, window, width, height);
+    scene->init(shader_loader);
+    scene->setInput(input.get());
+    scene->setRenderContext(options.render_thread ? &render_context : nullptr);
+}
+
+void Application::loadStressScene(const StressSceneConfig& config) {
+    current_scene_id = SceneLoader::STRESS_SCENE_ID;
+    scene = SceneLoader::loadStressScene(config, window, width, height);
+    scene->init(shader_loader);
+    scene->setRenderContext(options.render_thread ? &render_context : nullptr);
+}
+
+void Application::initInput() {
+    if (!options.record.empty() && !options.replay.empty()) {
+        fprintf(stderr, "ERROR: input cannot be recorded and replayed at once\n");
+        exit(EXIT_FAILURE);
+    }
+
+    try {
+        if (!options.record.empty()) {
+            if (options.headless) {
+                fprintf(stderr, "ERROR: recording input needs a window\n");
+                exit(EXIT_FAILURE);
+            }
+            InputRecordingHeader header{static_cast<uint32_t>(time(nullptr)), current_scene_id, width, height};
+            input = std::make_unique<InputRecorder>(InputMode::RECORD, options.record, header);
+        } else if (!options.replay.empty()) {
+            input = std::make_unique<InputRecorder>(InputMode::REPLAY, options.replay);
+            const auto& header = input->getHeader();
+            current_scene_id = header.scene;
+            // picking reads the framebuffer, clicks only land on the same pixels at the recorded size
+            if (header.width != width || header.height != height)
+                printf("WARNING: recorded at %dx%d, replaying at %dx%d, picking may differ\n",
+                       header.width, header.height, width, height);
+        }
+    } catch (const std::runtime_error& e) {
+        fprintf(stderr, "ERROR: %s\n", e.what());
+        exit(EXIT_FAILURE);
+    }
+
+    if (input == nullptr)
+        return;
+    input->setHandlers({
+            [this](int key, int scancode, int action, int mods) { handleKeyEvent(key, scancode, action, mods); },
+            [this](double x, double y) { handleCursorEvent(x, y); },
+            [this](int button, int action, int mode) { handleMouseButtonEvent(button, action, mode); },
+    });
+}
+
+void Application::initRenderContext() {
+#ifdef ZPG_ENABLE_HEADLESS
+    if (headless != nullptr) {
+        render_context = {[this] { headless->makeCurrent(); },
+                          [this] { headless->release(); },
+                          [] {}};
+        return;
+    }
+#endif
+    render_context = {[this] { glfwMakeContextCurrent(window); },
+                      [] { glfwMakeContextCurrent(nullptr); },
+                      [this] { glfwSwapBuffers(window); }};
+}
+
+void Application::initWindow() {
     glfwSetErrorCallback(errorCallback);
     if (!glfwInit()) {
         fprintf(stderr, "ERROR: could not start GLFW3\n");
         exit(EXIT_FAILURE);
     }
 
+    glfwWindowHint(GLFW_DEPTH_BITS, 24);
     window = glfwCreateWindow(width, height, title, nullptr, nullptr);
     if (!window) {
         glfwTerminate();
@@ -50,24 +169,9 @@ void Application::init() {
     glewInit();
 
     glfwGetFramebufferSize(window, &width, &height);
-    ratio = static_cast<float>(width) / static_cast<float>(height);
-    glViewport(0, 0, width, height);
 
     glfwSetWindowUserPointer(window, this);
 
-    /*
-     * Buffer settings
-     *
-     * Z-buffer */
-    glfwWindowHint(GLFW_DEPTH_BITS, 24);
-    glDepthMask(GL_TRUE);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-
-    // Stencil buffer
-    glEnable(GL_STENCIL_TEST);
-    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-
     glfwSetKeyCallback(window, keyCallback);
     glfwSetWindowCloseCallback(window, windowCloseCallback);
     glfwSetCursorPosCallback(window, cursorCallback);
@@ -80,37 +184,65 @@ void Application::init() {
         glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
     if (DISABLE_VSYNC)
         glfwSwapInterval(0);
-    if (ENABLE_CULL_FACE)
-        glEnable(GL_CULL_FACE);
-
-    glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
-
-    shader_loader = std::make_shared<ShaderLoader>();
-    shader_loader->loadShaders();
+}
 
-    // init shader uniform locations
-    for (auto shader: *this->shader_loader) {
-        shader->initUniforms();
+void Application::initHeadless() {
+#ifdef ZPG_ENABLE_HEADLESS
+    headless = std::make_unique<HeadlessContext>(width, height);
+    try {
+        headless->init();
+    } catch (const std::runtime_error& e) {
+        fprintf(stderr, "ERROR: could not create headless context: %s\n", e.what());
+        exit(EXIT_FAILURE);
     }
-
-    scene = SceneLoader::loadScene(&current_scene_id, *window, width, height);
-    scene->init(shader_loader);
+#else
+    fprintf(stderr, "ERROR: headless mode needs a build with ZPG_ENABLE_HEADLESS\n");
+    exit(EXIT_FAILURE);
+#endif
 }
 
 void Application::nextScene() {
-    glfwSetCursorPos(window, width / 2., height / 2.);
+    if (window != nullptr)
+        glfwSetCursorPos(window, width / 2., height / 2.);
     current_scene_id++;
     scene->finish();
 }
 
 void Application::run() {
+    if (options.headless) {
+        runHeadless();
+        return;
+    }
+
     do {
         if (scene->getSceneId() != this->current_scene_id) {
-            scene = SceneLoader::loadScene(&current_scene_id, *window, width, height);
-            scene->init(shader_loader);
+            loadScene(current_scene_id);
         }
         scene->run();
-    } while (!glfwWindowShouldClose(window));
+    } while (!glfwWindowShouldClose(window) && !(input != nullptr && input->isFinished()));
+}
+
+void Application::runHeadless() {
+    scene->setFixedTimeStep(HEADLESS_FRAME_TIME);
+    if (input != nullptr) {
+        // frames are paced by the recording, scenes change where they did when recorded
+        while (!input->isFinished()) {
+            if (scene->getSceneId() != this->current_scene_id)
+                loadScene(current_scene_id);
+            scene->run();
+            // finished without a scene switch, Escape was replayed (there is no window to close)
+            if (scene->getSceneId() == this->current_scene_id)
+                break;
+        }
+    } else {
+        scene->setFrameLimit(options.frames);
+        scene->run();
+    }
+
+#ifdef ZPG_ENABLE_HEADLESS
+    if (!options.output.empty())
+        headless->saveFrame(options.output);
+#endif
 }
 
 void Application::errorCallback(int error, const char* description) {
@@ -119,6 +251,12 @@ void Application::errorCallback(int error, const char* description) {
 
 void Application::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+    if (app->input != nullptr) {
+        // live input is ignored during a replay, except for leaving it
+        if (app->input->isReplaying() && key != GLFW_KEY_ESCAPE)
+            return;
+        app->input->recordKey(key, scancode, action, mods);
+    }
 
     // Call a member function to handle the key event
     app->handleKeyEvent(key, scancode, action, mods);
@@ -126,11 +264,18 @@ void Application::keyCallback(GLFWwindow* window, int key, int scancode, int act
 
 void Application::handleKeyEvent(int key, int scancode, int action, int mods) {
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
-        glfwSetWindowShouldClose(window, GL_TRUE);
+        if (window != nullptr)
+            glfwSetWindowShouldClose(window, GL_TRUE);
         scene->finish();
     } else if (key == GLFW_KEY_F2 && action == GLFW_PRESS) {
         nextScene();
-    } else if (key == GLFW_KEY_TAB && action == GLFW_PRESS) {
+    } else if (key == GLFW_KEY_F4 && action == GLFW_PRESS) {
+        RenderStats::toggleDump();
+#ifdef ZPG_ENABLE_PROFILER
+    } else if (key == GLFW_KEY_F3 && action == GLFW_PRESS) {
+        Profiler::get().toggleCapture();
+#endif
+    } else if (key == GLFW_KEY_TAB && action == GLFW_PRESS && window != nullptr) {
         if (glfwGetInputMode(window, GLFW_CURSOR) == GLFW_CURSOR_DISABLED)
             glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
         else if (glfwGetInputMode(window, GLFW_CURSOR) == GLFW_CURSOR_NORMAL)
@@ -157,9 +302,8 @@ void Application::windowIconifyCallback(GLFWwindow* window, int iconified) {
 
 void Application::windowSizeCallback(GLFWwindow* window, int width, int height) {
     // printf("resize %d, %d \n", width, height);
-    glViewport(0, 0, width, height);
-
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+    app->scene->onRenderThread([width, height] { glViewport(0, 0, width, height); });
     app->update_scene_aspect(width, height);
 }
 
@@ -171,6 +315,11 @@ void Application::update_scene_aspect(const int& new_width, const int& new_heigh
 
 void Application::cursorCallback(GLFWwindow* window, double x, double y) {
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+    if (app->input != nullptr) {
+        if (app->input->isReplaying())
+            return;
+        app->input->recordCursor(x, y);
+    }
     app->handleCursorEvent(x, y);
 }
 
@@ -180,6 +329,11 @@ void Application::handleCursorEvent(double x_pos, double y_pos) {
 
 void Application::buttonCallback(GLFWwindow* window, int button, int action, int mode) {
     auto* app = static_cast<Application*>(glfwGetWindowUserPointer(window));
+    if (app->input != nullptr) {
+        if (app->input->isReplaying())
+            return;
+        app->input->recordButton(button, action, mode);
+    }
     app->handleMouseButtonEvent(button, action, mode);
 }
 
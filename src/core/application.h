@@ -16,16 +16,44 @@
 #include <string>
 
 #include "scene.h"
+#include "headless_context.h"
+#include "input_recorder.h"
 #include "loaders/scene_loader.h"
 #include "../shaders/shader_loader.h"
 #include "../models/drawable.h"
 
+struct LaunchOptions {
+    // render offscreen without a window or input, see HeadlessContext
+    bool headless = false;
+    int frames = HEADLESS_DEFAULT_FRAMES;
+    int scene = DEFAULT_SCENE;
+    // PPM file receiving the last headless frame, nothing is written when empty
+    std::string output;
+    // binary input recording written during the session, see InputRecorder
+    std::string record;
+    // input recording injected instead of live input, runs until the recording ends
+    std::string replay;
+    // simulate and draw on separate threads, see RenderThread
+    bool render_thread = false;
+    // scenes show placeholders while their assets load in the background, see AsyncLoader
+    // only windowed sessions without input recordings do, the others have to be reproducible frame by frame
+    bool async_loading = true;
+};
+
 class Application {
 private:
-    GLFWwindow* window;
+    LaunchOptions options;
+#ifdef ZPG_ENABLE_HEADLESS
+    // declared first, the context has to outlive every GL object below
+    std::unique_ptr<HeadlessContext> headless;
+#endif
+    GLFWwindow* window = nullptr;
     std::shared_ptr<ShaderLoader> shader_loader;
+    std::unique_ptr<InputRecorder> input;
+    // how scenes hand the context to their render thread
+    RenderContext render_context;
 
-    int current_scene_id = DEFAULT_SCENE;
+    int current_scene_id;
     std::unique_ptr<Scene> scene;
 
     const char* title;
@@ -33,15 +61,26 @@ private:
     int width;
     int height;
 
+    void initWindow();
+    void initHeadless();
+    void initInput();
+    void initRenderContext();
+    void runHeadless();
     void nextScene();
     void update_scene_aspect(const int& new_width, const int& new_height);
 public:
-    Application(int width, int height, const char* title);
+    Application(int width, int height, const char* title, LaunchOptions options = {});
     ~Application();
 
     void init();
     static void info();
     void run();
+    // replace the current scene with the SceneLoader scene of the given index
+    void loadScene(int scene_id);
+    void loadStressScene(const StressSceneConfig& config);
+    [[nodiscard]] Scene& getScene() { return *scene; }
+    [[nodiscard]] int getWidth() const { return width; }
+    [[nodiscard]] int getHeight() const { return height; }
 
     void handleKeyEvent(int key, int scancode, int action, int mods);
     void handleCursorEvent(double x_pos, double y_pos);
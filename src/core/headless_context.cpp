@@ -0,0 +1,142 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include "headless_context.h"
+
+#ifdef ZPG_ENABLE_HEADLESS
+
+#include <EGL/eglext.h>
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+HeadlessContext::~HeadlessContext() {
+    if (context != EGL_NO_CONTEXT) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteRenderbuffers(1, &depth_stencil_buffer);
+        glDeleteRenderbuffers(1, &color_buffer);
+        glDeleteFramebuffers(1, &framebuffer);
+
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+    }
+    if (display != EGL_NO_DISPLAY)
+        eglTerminate(display);
+}
+
+EGLDisplay HeadlessContext::openDisplay() {
+    // prefer the surfaceless platform, it needs neither X11/Wayland nor a DRM device
+    const char* client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (client_extensions != nullptr && std::strstr(client_extensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+        auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display != nullptr) {
+            EGLDisplay surfaceless = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (surfaceless != EGL_NO_DISPLAY)
+                return surfaceless;
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+void HeadlessContext::init() {
+    display = openDisplay();
+    if (display == EGL_NO_DISPLAY)
+        throw std::runtime_error("HeadlessContext::init: No EGL display available");
+
+    EGLint major, minor;
+    if (!eglInitialize(display, &major, &minor))
+        throw std::runtime_error("HeadlessContext::init: eglInitialize failed");
+    printf("Using EGL %i.%i (%s)\n", major, minor, eglQueryString(display, EGL_VENDOR));
+
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (extensions == nullptr || std::strstr(extensions, "EGL_KHR_surfaceless_context") == nullptr)
+        throw std::runtime_error("HeadlessContext::init: EGL_KHR_surfaceless_context not supported");
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+        throw std::runtime_error("HeadlessContext::init: Desktop OpenGL not supported by EGL");
+
+    // no surface is ever created, the config only has to be OpenGL renderable
+    const EGLint config_attributes[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_SURFACE_TYPE, 0,
+            EGL_NONE
+    };
+    EGLConfig config;
+    EGLint config_count = 0;
+    if (!eglChooseConfig(display, config_attributes, &config, 1, &config_count) || config_count == 0)
+        throw std::runtime_error("HeadlessContext::init: No matching EGL config");
+
+    // default attributes, same compatibility context GLFW creates for the window
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+    if (context == EGL_NO_CONTEXT)
+        throw std::runtime_error("HeadlessContext::init: eglCreateContext failed");
+
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+        throw std::runtime_error("HeadlessContext::init: eglMakeCurrent failed");
+
+    // GLEW built for GLX reports a missing GLX display, the core entry points are loaded before that check
+    glewExperimental = GL_TRUE;
+    glewInit();
+    if (glGenFramebuffers == nullptr)
+        throw std::runtime_error("HeadlessContext::init: Loading OpenGL functions failed");
+
+    createFramebuffer();
+}
+
+void HeadlessContext::makeCurrent() const {
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+        throw std::runtime_error("HeadlessContext::makeCurrent: eglMakeCurrent failed");
+}
+
+void HeadlessContext::release() const {
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+void HeadlessContext::createFramebuffer() {
+    glGenRenderbuffers(1, &color_buffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, color_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    // stencil is needed for object picking, same layout as the default framebuffer
+    glGenRenderbuffers(1, &depth_stencil_buffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_stencil_buffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth_stencil_buffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        throw std::runtime_error("HeadlessContext::createFramebuffer: Framebuffer incomplete");
+
+    // stays bound for the whole run, the scene draws into it as if it were the window
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+}
+
+void HeadlessContext::saveFrame(const std::string& path) const {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        throw std::runtime_error("HeadlessContext::saveFrame: Cannot open " + path);
+
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    // OpenGL rows start at the bottom
+    const size_t row_size = static_cast<size_t>(width) * 3;
+    for (int y = height - 1; y >= 0; y--) {
+        fwrite(pixels.data() + y * row_size, 1, row_size, file);
+    }
+    fclose(file);
+    printf("Frame written to %s\n", path.c_str());
+}
+
+#endif //ZPG_ENABLE_HEADLESS
@@ -0,0 +1,57 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_HEADLESS_CONTEXT_H
+#define ZPG_HEADLESS_CONTEXT_H
+
+#ifdef ZPG_ENABLE_HEADLESS
+
+//Include GLEW
+#include <GL/glew.h>
+//Include EGL
+#include <EGL/egl.h>
+
+#include <string>
+
+//
+// Offscreen OpenGL context for machines without a display.
+// A surfaceless EGL context (EGL_MESA_platform_surfaceless) is created and every frame is rendered
+// into a framebuffer object of a fixed size, so Mesa's llvmpipe/softpipe drivers work without a GPU.
+//
+class HeadlessContext {
+private:
+    int width;
+    int height;
+
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+
+    GLuint framebuffer = 0;
+    GLuint color_buffer = 0;
+    GLuint depth_stencil_buffer = 0;
+private:
+    static EGLDisplay openDisplay();
+    void createFramebuffer();
+public:
+    HeadlessContext(int width, int height) : width(width), height(height) {}
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // creates the context, makes it current, loads GL entry points and binds the framebuffer
+    void init();
+    // hand the context to the calling thread, see RenderThread
+    void makeCurrent() const;
+    void release() const;
+    // reads the color attachment back and writes it as a binary PPM
+    void saveFrame(const std::string& path) const;
+
+    [[nodiscard]] int getWidth() const { return width; }
+    [[nodiscard]] int getHeight() const { return height; }
+};
+
+#endif //ZPG_ENABLE_HEADLESS
+
+#endif //ZPG_HEADLESS_CONTEXT_H
@@ -0,0 +1,162 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <cstring>
+#include <stdexcept>
+
+#include "input_recorder.h"
+#include "../util/const.h"
+
+namespace {
+    enum RecordType : uint8_t {
+        RECORD_TICK = 0,
+        RECORD_KEY = 1,
+        RECORD_CURSOR = 2,
+        RECORD_BUTTON = 3,
+    };
+}
+
+InputRecorder::InputRecorder(InputMode mode, const std::string& path, const InputRecordingHeader& header) :
+        mode(mode), header(header) {
+    file = fopen(path.c_str(), mode == InputMode::RECORD ? "wb" : "rb");
+    if (file == nullptr)
+        throw std::runtime_error("InputRecorder::InputRecorder: Cannot open " + path);
+
+    if (mode == InputMode::RECORD) {
+        write(INPUT_RECORDING_MAGIC, sizeof(INPUT_RECORDING_MAGIC));
+        write(&INPUT_RECORDING_VERSION, sizeof(INPUT_RECORDING_VERSION));
+        write(&this->header, sizeof(this->header));
+        printf("Recording input to %s\n", path.c_str());
+        return;
+    }
+
+    char magic[sizeof(INPUT_RECORDING_MAGIC)];
+    uint32_t version;
+    if (!read(magic, sizeof(magic)) || std::memcmp(magic, INPUT_RECORDING_MAGIC, sizeof(magic)) != 0) {
+        fclose(file);
+        throw std::runtime_error("InputRecorder::InputRecorder: " + path + " is not an input recording");
+    }
+    if (!read(&version, sizeof(version)) || version != INPUT_RECORDING_VERSION || !read(&this->header, sizeof(this->header))) {
+        fclose(file);
+        throw std::runtime_error("InputRecorder::InputRecorder: Unsupported recording version in " + path);
+    }
+    printf("Replaying input from %s\n", path.c_str());
+}
+
+InputRecorder::~InputRecorder() {
+    if (file != nullptr)
+        fclose(file);
+}
+
+void InputRecorder::write(const void* data, size_t size) {
+    if (fwrite(data, 1, size, file) != size)
+        throw std::runtime_error("InputRecorder::write: Writing the recording failed");
+}
+
+bool InputRecorder::read(void* data, size_t size) {
+    return fread(data, 1, size, file) == size;
+}
+
+float InputRecorder::beginFrame(float delta_time) {
+    if (mode == InputMode::RECORD) {
+        const uint8_t type = RECORD_TICK;
+        write(&type, sizeof(type));
+        write(&delta_time, sizeof(delta_time));
+        tick++;
+        return delta_time;
+    }
+
+    // dispatch() stops in front of every tick record
+    uint8_t type;
+    float recorded_delta_time;
+    if (finished || !read(&type, sizeof(type)) || type != RECORD_TICK
+        || !read(&recorded_delta_time, sizeof(recorded_delta_time))) {
+        if (!finished)
+            printf("Replay finished after %u frames\n", tick);
+        finished = true;
+        return delta_time;
+    }
+    tick++;
+    return recorded_delta_time;
+}
+
+void InputRecorder::dispatch() {
+    if (mode != InputMode::REPLAY || finished)
+        return;
+
+    int type;
+    while ((type = fgetc(file)) != EOF) {
+        switch (type) {
+            case RECORD_TICK:
+                // belongs to the next frame
+                ungetc(type, file);
+                return;
+            case RECORD_KEY: {
+                int32_t key, scancode;
+                uint8_t action, mods;
+                if (!read(&key, sizeof(key)) || !read(&scancode, sizeof(scancode))
+                    || !read(&action, sizeof(action)) || !read(&mods, sizeof(mods)))
+                    break;
+                if (handlers.key)
+                    handlers.key(key, scancode, action, mods);
+                continue;
+            }
+            case RECORD_CURSOR: {
+                double x, y;
+                if (!read(&x, sizeof(x)) || !read(&y, sizeof(y)))
+                    break;
+                if (handlers.cursor)
+                    handlers.cursor(x, y);
+                continue;
+            }
+            case RECORD_BUTTON: {
+                uint8_t button, action, mods;
+                if (!read(&button, sizeof(button)) || !read(&action, sizeof(action)) || !read(&mods, sizeof(mods)))
+                    break;
+                if (handlers.button)
+                    handlers.button(button, action, mods);
+                continue;
+            }
+            default:
+                break;
+        }
+        // truncated record or unknown type, nothing after it can be trusted
+        printf("Corrupted input recording at frame %u, replay stopped\n", tick);
+        finished = true;
+        return;
+    }
+}
+
+void InputRecorder::recordKey(int key, int scancode, int action, int mods) {
+    if (mode != InputMode::RECORD)
+        return;
+    const uint8_t type = RECORD_KEY;
+    const int32_t key_record = key, scancode_record = scancode;
+    const uint8_t action_record = action, mods_record = mods;
+    write(&type, sizeof(type));
+    write(&key_record, sizeof(key_record));
+    write(&scancode_record, sizeof(scancode_record));
+    write(&action_record, sizeof(action_record));
+    write(&mods_record, sizeof(mods_record));
+}
+
+void InputRecorder::recordCursor(double x, double y) {
+    if (mode != InputMode::RECORD)
+        return;
+    const uint8_t type = RECORD_CURSOR;
+    write(&type, sizeof(type));
+    write(&x, sizeof(x));
+    write(&y, sizeof(y));
+}
+
+void InputRecorder::recordButton(int button, int action, int mods) {
+    if (mode != InputMode::RECORD)
+        return;
+    const uint8_t type = RECORD_BUTTON;
+    const uint8_t button_record = button, action_record = action, mods_record = mods;
+    write(&type, sizeof(type));
+    write(&button_record, sizeof(button_record));
+    write(&action_record, sizeof(action_record));
+    write(&mods_record, sizeof(mods_record));
+}
@@ -0,0 +1,81 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_INPUT_RECORDER_H
+#define ZPG_INPUT_RECORDER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+enum class InputMode {
+    RECORD,
+    REPLAY,
+};
+
+// state the recorded session started from, restored before a replay
+struct InputRecordingHeader {
+    // rand() seed used before every scene load
+    uint32_t seed = 0;
+    int32_t scene = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+};
+
+// receivers of replayed events, same arguments as the GLFW callbacks
+struct InputHandlers {
+    std::function<void(int key, int scancode, int action, int mods)> key;
+    std::function<void(double x, double y)> cursor;
+    std::function<void(int button, int action, int mods)> button;
+};
+
+//
+// Records GLFW input into a compact binary file and injects it back at the same simulation ticks.
+// Every frame starts with a tick record holding its delta time (as passed to Scene::frame),
+// events polled after that frame follow it. A replay therefore advances with the recorded steps
+// and sees every event between the same two frames, which makes the whole session deterministic.
+// Values are stored in native byte order, recordings are not meant to move between architectures.
+//
+class InputRecorder {
+private:
+    InputMode mode;
+    FILE* file = nullptr;
+    InputRecordingHeader header;
+    InputHandlers handlers;
+
+    uint32_t tick = 0;
+    bool finished = false;
+private:
+    void write(const void* data, size_t size);
+    bool read(void* data, size_t size);
+public:
+    // RECORD writes the header right away, REPLAY reads it from the file
+    InputRecorder(InputMode mode, const std::string& path, const InputRecordingHeader& header = {});
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    void setHandlers(InputHandlers new_handlers) { handlers = std::move(new_handlers); }
+
+    // called before every frame, returns the delta time the frame has to use
+    float beginFrame(float delta_time);
+    // replay only, injects the events recorded after the current frame
+    void dispatch();
+
+    void recordKey(int key, int scancode, int action, int mods);
+    void recordCursor(double x, double y);
+    void recordButton(int button, int action, int mods);
+
+    [[nodiscard]] bool isRecording() const { return mode == InputMode::RECORD; }
+    [[nodiscard]] bool isReplaying() const { return mode == InputMode::REPLAY; }
+    // replay ran out of recorded frames
+    [[nodiscard]] bool isFinished() const { return finished; }
+    [[nodiscard]] const InputRecordingHeader& getHeader() const { return header; }
+    [[nodiscard]] uint32_t getTick() const { return tick; }
+};
+
+
+#endif //ZPG_INPUT_RECORDER_H
@@ -2,8 +2,14 @@
 // E-Mail: sla0331@vsb.cz
 // Date of Creation:  19/11/2023
 
+#include <memory>
 #include <stdexcept>
 #include "asset_loader.h"
+#include "../../models/mesh_file.h"
+#include "../../models/mesh_optimizer.h"
+#include "../../models/vertex_format.h"
+#include "../../util/const.h"
+#include "../../util/profiler.h"
 
 AssetLoader::~AssetLoader() {
     for (auto& model : model_repository) {
@@ -13,62 +19,110 @@ AssetLoader::~AssetLoader() {
 
 
 const Asset* AssetLoader::loadAssetModel(const char* filename) {
-    std::string path = std::string(ASSETS_PATH) + filename;
     auto it = model_repository.find(filename);
     if (it == model_repository.end()) {
-        // load the file
-        const aiScene* scene = importer.ReadFile(path.c_str(), importOptions);
-        auto* asset = new Asset{readAssetModel(scene), readMaterial(scene)};
-
-        model_repository[filename] = asset;
-        return model_repository[filename];
+        ZPG_PROFILE_SCOPE("AssetLoader::loadAssetModel");
+        auto asset = std::make_unique<Asset>();
+        readAsset(filename, asset.get())();
+        model_repository[filename] = asset.get();
+        return asset.release();
     }
     return it->second;
 }
 
-Model AssetLoader::readAssetModel(const aiScene* scene) {
+const Asset* AssetLoader::requestAssetModel(const char* filename) {
+    auto it = model_repository.find(filename);
+    if (it != model_repository.end())
+        return it->second;
+
+    auto* asset = new Asset();
+    model_repository[filename] = asset;
+    AsyncLoader::getInstance().submit(filename, [filename, asset] { return readAsset(filename, asset); });
+    return asset;
+}
+
+AsyncLoader::Upload AssetLoader::readAsset(const char* filename, Asset* asset) {
+    if (MeshFile::exists(getMeshPath(filename))) {
+        // converted by zpg_meshc, mapped and uploaded as is
+        auto file = std::make_shared<MeshFile>(getMeshPath(filename));
+        return [asset, file] {
+            asset->model.upload(file->getData());
+            if (file->hasMaterial())
+                asset->material = file->getMaterial();
+        };
+    }
+
+    // an importer per call, workers import in parallel
+    Assimp::Importer importer;
+    std::string path = std::string(ASSETS_PATH) + filename;
+    const aiScene* scene = importer.ReadFile(path.c_str(), importOptions);
     if (!scene)
-        throw std::runtime_error("ModelLoader::readAssetModel: " + std::string(importer.GetErrorString()));
+        throw std::runtime_error("AssetLoader::readAsset: " + std::string(importer.GetErrorString()));
+
+    auto mesh = std::make_shared<EncodedMesh>(prepareMesh(scene, filename));
+    Material material = readMaterial(scene);
+    return [asset, mesh, material] {
+        asset->model.upload(mesh->getData());
+        asset->material = material;
+    };
+}
+
+std::string AssetLoader::getMeshPath(const char* filename) {
+    std::string name(filename);
+    size_t extension = name.find_last_of('.');
+    if (extension != std::string::npos)
+        name.erase(extension);
+    return std::string(MESHES_PATH) + name + MESH_FILE_EXTENSION;
+}
 
+EncodedMesh AssetLoader::prepareMesh(const aiScene* scene, const char* name) {
     if (scene->mNumMeshes != 1)
-        throw std::runtime_error("ModelLoader::readAssetModel: Only one mesh per file is supported");
+        throw std::runtime_error("AssetLoader::prepareMesh: Only one mesh per file is supported");
 
     // read vertices, normals and texture uv's
+    // assimp already joined identical vertices, keep its indexing instead of expanding every face
     aiMesh* mesh = scene->mMeshes[0];
-    auto data = std::vector<float>();
+    IndexedMesh data;
+    data.stride = 8;
+    data.vertices.reserve(mesh->mNumVertices * 8);
+    for (unsigned int id = 0; id < mesh->mNumVertices; id++) {
+        //Vertex position
+        aiVector3D pos = mesh->mVertices[id];
+        data.vertices.push_back(pos.x);
+        data.vertices.push_back(pos.y);
+        data.vertices.push_back(pos.z);
+
+        //Vertex normal
+        aiVector3D nor = mesh->mNormals[id];
+        data.vertices.push_back(nor.x);
+        data.vertices.push_back(nor.y);
+        data.vertices.push_back(nor.z);
+
+        //Vertex uv
+        aiVector3D uv = mesh->mTextureCoords[0][id];
+        data.vertices.push_back(uv.x);
+        data.vertices.push_back(uv.y);
+    }
+
+    data.indices.reserve(mesh->mNumFaces * 3);
     for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
         aiFace face = mesh->mFaces[i];
 
         for (unsigned int j = 0; j < 3; j++)
-        {
-            int id = face.mIndices[j];
-
-            //Vertex position
-            aiVector3D pos = mesh->mVertices[id];
-            data.push_back(pos.x);
-            data.push_back(pos.y);
-            data.push_back(pos.z);
-
-            //Vertex normal
-            aiVector3D nor = mesh->mNormals[id];
-            data.push_back(nor.x);
-            data.push_back(nor.y);
-            data.push_back(nor.z);
-
-            //Vertex uv
-            aiVector3D uv = mesh->mTextureCoords[0][id];
-            data.push_back(uv.x);
-            data.push_back(uv.y);
-        }
+            data.indices.push_back(face.mIndices[j]);
     }
 
-    return Model(data.data(), static_cast<int>(data.size()), static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::NORMALS | ModelOptions::TEXTURED_UV));
+    if (ENABLE_MESH_OPTIMIZATION)
+        MeshOptimizer::optimize(data, name);
+
+    return EncodedMesh::encode(VertexFormat::compress(static_cast<ModelOptions>(ModelOptions::VERTICES
+                                                                                | ModelOptions::NORMALS
+                                                                                | ModelOptions::TEXTURED_UV)),
+                               data.vertices.data(), static_cast<int>(data.getVertexCount()),
+                               data.indices.data(), static_cast<int>(data.indices.size()));
 }
 
 Material AssetLoader::readMaterial(const aiScene* scene) {
-    if (!scene)
-        throw std::runtime_error("ModelLoader::readTexture: " + std::string(importer.GetErrorString()));
-
 //    if (scene->mNumMaterials != 1)
 //        throw std::runtime_error("ModelLoader::readTexture: Only one material per file is supported");
 
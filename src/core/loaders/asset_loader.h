@@ -10,9 +10,12 @@
 #include<assimp/postprocess.h>
 
 #include <map>
+#include <string>
 
 #include "../../models/model.h"
+#include "../../models/mesh_data.h"
 #include "../../models/properties/material.h"
+#include "async_loader.h"
 
 static constexpr unsigned int importOptions = aiProcess_Triangulate
                                               | aiProcess_OptimizeMeshes              // reduce the number of draw calls
@@ -20,14 +23,14 @@ static constexpr unsigned int importOptions = aiProcess_Triangulate
                                               | aiProcess_Triangulate                 // triangulates all faces of all meshes
                                               | aiProcess_CalcTangentSpace;           // calculates the tangents and bitangents for the imported meshes
 
+// handed out as const, the loader fills in placeholders once they are loaded
 struct Asset {
-    const Model model;
-    const Material material;
+    Model model;
+    Material material;
 };
 
 class AssetLoader {
 private:
-    Assimp::Importer importer;
     std::map<const char*, Asset*> model_repository;
 
     // Private constructor to prevent instantiation
@@ -35,8 +38,9 @@ private:
     ~AssetLoader();
 
 private:
-    Model readAssetModel(const aiScene* scene);
-    Material readMaterial(const aiScene* scene);
+    // the converted assets/meshes/<name>.zmesh when there is one, otherwise the file is imported by assimp.
+    // Touches no GL and no loader state, the returned upload fills the asset in.
+    static AsyncLoader::Upload readAsset(const char* filename, Asset* asset);
 public:
     AssetLoader(AssetLoader const&) = delete;
     void operator=(AssetLoader const&) = delete;
@@ -49,6 +53,14 @@ public:
 
 
     const Asset* loadAssetModel(const char* filename);
+    // placeholder asset read by an AsyncLoader worker, loadAssetModel returns it while it is not uploaded yet
+    const Asset* requestAssetModel(const char* filename);
+
+    // the steps of an import, static so that zpg_meshc can run them without a GL context
+    static EncodedMesh prepareMesh(const aiScene* scene, const char* name);
+    static Material readMaterial(const aiScene* scene);
+    // assets/meshes/<filename without extension>.zmesh
+    static std::string getMeshPath(const char* filename);
 };
 
 
@@ -0,0 +1,112 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+#include "async_loader.h"
+#include "../../util/const.h"
+#include "../../util/profiler.h"
+
+AsyncLoader::~AsyncLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        // jobs nobody started are dropped, their placeholders stay
+        jobs.clear();
+    }
+    wake.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+void AsyncLoader::submit(std::string name, Job job) {
+    pending++;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (workers.empty()) {
+            for (int i = 0; i < std::max(ASYNC_LOADER_WORKERS, 1); i++) {
+                workers.emplace_back(&AsyncLoader::loop, this);
+            }
+        }
+        jobs.push_back(PendingJob{std::move(name), std::move(job)});
+    }
+    wake.notify_one();
+}
+
+void AsyncLoader::loop() {
+    while (true) {
+        PendingJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping)
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        Result result;
+        result.name = std::move(job.name);
+        try {
+            ZPG_PROFILE_SCOPE("AsyncLoader::job");
+            result.upload = job.job();
+        } catch (...) {
+            result.error = std::current_exception();
+        }
+
+        // e.g. a cube map face, the job decoding the last one uploads all of them
+        if (!result.upload && !result.error) {
+            pending--;
+            continue;
+        }
+        results.push(std::move(result));
+        ready++;
+    }
+}
+
+void AsyncLoader::run(Result& result) {
+    try {
+        if (result.error)
+            std::rethrow_exception(result.error);
+        ZPG_PROFILE_SCOPE("AsyncLoader::upload");
+        result.upload();
+    } catch (const std::exception& e) {
+        // the placeholder stays, the scene goes on without the asset
+        fprintf(stderr, "ERROR: loading %s failed: %s\n", result.name.c_str(), e.what());
+    }
+    pending--;
+}
+
+size_t AsyncLoader::upload(double budget_ms) {
+    const auto start = std::chrono::steady_clock::now();
+    size_t count = 0;
+    Result result;
+    while (results.pop(result)) {
+        ready--;
+        run(result);
+        count++;
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budget_ms)
+            break;
+    }
+    return count;
+}
+
+void AsyncLoader::finish() {
+    ZPG_PROFILE_SCOPE("AsyncLoader::finish");
+    Result result;
+    while (pending > 0) {
+        if (!results.pop(result)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        ready--;
+        run(result);
+    }
+}
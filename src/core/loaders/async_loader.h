@@ -0,0 +1,96 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_ASYNC_LOADER_H
+#define ZPG_ASYNC_LOADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../util/mpsc_queue.h"
+
+//
+// Background loading of scene assets.
+// A job reads, imports or decodes an asset on a worker thread without touching GL and returns the upload,
+// which the thread owning the context runs later through upload(), a few milliseconds worth every frame.
+// Finished jobs reach that thread through a lock-free queue, workers never wait on it.
+//
+// The loaders hand out placeholders right away (a Model without buffers, a texture holding PLACEHOLDER_TEXEL)
+// and the uploads fill the very same objects in, so scenes keep their pointers.
+//
+class AsyncLoader {
+public:
+    // GL thread, fills the placeholder with what the job decoded
+    using Upload = std::function<void()>;
+    // worker thread, an empty upload means there is nothing to upload (yet)
+    using Job = std::function<Upload()>;
+private:
+    struct PendingJob {
+        std::string name;
+        Job job;
+    };
+
+    struct Result {
+        std::string name;
+        Upload upload;
+        // the job failed, reported on upload instead
+        std::exception_ptr error;
+    };
+
+    bool enabled = false;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<PendingJob> jobs;
+    bool stopping = false;
+
+    MpscQueue<Result> results;
+    // submitted jobs whose upload did not run yet
+    std::atomic<size_t> pending{0};
+    // results pushed and not popped yet
+    std::atomic<size_t> ready{0};
+
+    // Private constructor to prevent instantiation
+    AsyncLoader() { }
+    ~AsyncLoader();
+private:
+    void loop();
+    void run(Result& result);
+public:
+    AsyncLoader(AsyncLoader const&) = delete;
+    void operator=(AsyncLoader const&) = delete;
+
+    // Singleton
+    static AsyncLoader& getInstance() {
+        static AsyncLoader instance;
+        return instance;
+    }
+
+    // scenes load through the loaders' request functions only when enabled, see SceneLoader
+    void setEnabled(bool value) { enabled = value; }
+    [[nodiscard]] bool isEnabled() const { return enabled; }
+
+    // any thread, workers are started with the first job
+    void submit(std::string name, Job job);
+
+    // GL thread, runs finished uploads until budget_ms is spent, returns how many ran
+    size_t upload(double budget_ms);
+    // GL thread, waits for every submitted job and uploads it
+    void finish();
+
+    // some jobs finished and wait for upload()
+    [[nodiscard]] bool hasUploads() const { return ready > 0; }
+    [[nodiscard]] bool isIdle() const { return pending == 0; }
+};
+
+
+#endif //ZPG_ASYNC_LOADER_H
@@ -2,18 +2,24 @@
 // E-Mail: sla0331@vsb.cz
 // Date of Creation:  30/10/2023
 
+#include <memory>
 #include <stdexcept>
 #include "model_loader.h"
+#include "../../models/mesh_file.h"
+#include "../../models/mesh_optimizer.h"
+#include "../../models/vertex_format.h"
+#include "../../util/const.h"
+#include "../../util/profiler.h"
 
-#include "../../../assets/static/bushes.h"
-#include "../../../assets/static/gift.h"
-#include "../../../assets/static/plain.h"
-#include "../../../assets/static/sphere.h"
-#include "../../../assets/static/suzi_flat.h"
-#include "../../../assets/static/suzi_smooth.h"
-#include "../../../assets/static/tree.h"
-#include "../../../assets/static/square_uv.h"
-#include "../../../assets/static/cube.h"
+#ifdef ZPG_EMBED_STATIC_MESHES
+#include "static_meshes.h"
+#endif
+
+namespace {
+    // options describing the source arrays, a converted file has to agree with the key on them
+    constexpr uint32_t SOURCE_OPTIONS_MASK = ModelOptions::VERTICES | ModelOptions::NORMALS | ModelOptions::TEXTURED_UV
+                                             | ModelOptions::SKYBOX | ModelOptions::STRIP;
+}
 
 ModelLoader::~ModelLoader() {
     for (auto& model : model_repository) {
@@ -26,35 +32,77 @@ const Model* ModelLoader::loadModel(const char* name) {
 }
 
 const Model* ModelLoader::loadModel(const ModelKey& model_key) {
-    if (strcmp(model_key.name, "bushes") == 0) {
-        return loadModel(model_key, bushes, sizeof(bushes));
-    } else if (strcmp(model_key.name, "gift") == 0) {
-        return loadModel(model_key, gift, sizeof(gift));
-    } else if (strcmp(model_key.name, "plain") == 0) {
-        return loadModel(model_key, plain, sizeof(plain));
-    } else if (strcmp(model_key.name, "sphere") == 0) {
-        return loadModel(model_key, sphere, sizeof(sphere));
-    } else if (strcmp(model_key.name, "suzi_flat") == 0) {
-        return loadModel(model_key, suziFlat, sizeof(suziFlat));
-    } else if (strcmp(model_key.name, "suzi_smooth") == 0) {
-        return loadModel(model_key, suziSmooth, sizeof(suziSmooth));
-    } else if (strcmp(model_key.name, "tree") == 0) {
-        return loadModel(model_key, tree, sizeof(tree));
-    } else if (strcmp(model_key.name, "square_uv") == 0) {
-        return loadModel(model_key, square_uv, sizeof(square_uv));
-    } else if (strcmp(model_key.name, "cube") == 0) {
-        return loadModel(model_key, skycube, sizeof(skycube));
-    } else {
-        throw std::runtime_error("ModelLoader::loadModel: Unknown model name: " + std::string(model_key.name));
-    }
-}
-
-const Model* ModelLoader::loadModel(const ModelKey& model_key, const float* vertices, const int& vertices_size) {
     auto it = model_repository.find(model_key);
     if (it == model_repository.end()) {
-        auto* model = new Model(vertices, static_cast<int>(vertices_size / sizeof(float)), model_key.options);
-        model_repository[model_key] = model; // copying ModelKey
-        return model;
+        ZPG_PROFILE_SCOPE("ModelLoader::loadModel");
+        auto model = std::make_unique<Model>();
+        readMesh(model_key, model.get())();
+        model_repository[model_key] = model.get(); // copying ModelKey
+        return model.release();
     }
     return it->second;
 }
+
+const Model* ModelLoader::requestModel(const char* name) {
+    return this->requestModel(ModelKey{name, static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::NORMALS)});
+}
+
+const Model* ModelLoader::requestModel(const ModelKey& model_key) {
+    auto it = model_repository.find(model_key);
+    if (it != model_repository.end())
+        return it->second;
+
+    auto* model = new Model();
+    model_repository[model_key] = model;
+    const char* name = model_key.name;
+    ModelOptions options = model_key.options;
+    AsyncLoader::getInstance().submit(name, [name, options, model] {
+        return readMesh(ModelKey{name, options}, model);
+    });
+    return model;
+}
+
+#ifdef ZPG_EMBED_STATIC_MESHES
+
+AsyncLoader::Upload ModelLoader::readMesh(const ModelKey& model_key, Model* model) {
+    const StaticMesh* mesh = StaticMeshes::find(model_key.name);
+    if (mesh == nullptr)
+        throw std::runtime_error("ModelLoader::readMesh: Unknown model name: " + std::string(model_key.name));
+
+    auto encoded = std::make_shared<EncodedMesh>(prepareMesh(model_key.name, mesh->vertices,
+                                                             static_cast<int>(mesh->size / sizeof(float)),
+                                                             model_key.options));
+    return [model, encoded] { model->upload(encoded->getData()); };
+}
+
+#else
+
+AsyncLoader::Upload ModelLoader::readMesh(const ModelKey& model_key, Model* model) {
+    std::string path = std::string(MESHES_PATH) + model_key.name + MESH_FILE_EXTENSION;
+    if (!MeshFile::exists(path))
+        throw std::runtime_error("ModelLoader::readMesh: Unknown model name: " + std::string(model_key.name)
+                                 + " (" + path + " not found, build the zpg_meshes target)");
+
+    // the mapping is released right after the buffers are filled
+    auto file = std::make_shared<MeshFile>(path);
+    if ((file->getData().options & SOURCE_OPTIONS_MASK) != (model_key.options & SOURCE_OPTIONS_MASK))
+        throw std::runtime_error("ModelLoader::readMesh: " + path + " was converted with other model options");
+    return [model, file] { model->upload(file->getData()); };
+}
+
+#endif
+
+EncodedMesh ModelLoader::prepareMesh(const char* name, const float* vertices, int total_count, ModelOptions options) {
+    // the key keeps the options the scene asked for
+    options = VertexFormat::compress(options);
+    const int stride = Model::getStrideFromOptions(options);
+
+    // strips depend on the vertex order, only triangle lists can be reordered
+    if (!ENABLE_MESH_OPTIMIZATION || (options & ModelOptions::STRIP))
+        return EncodedMesh::weld(options, vertices, total_count / stride);
+
+    IndexedMesh mesh = MeshOptimizer::weld(vertices, total_count / stride, stride);
+    MeshOptimizer::optimize(mesh, name);
+    return EncodedMesh::encode(options, mesh.vertices.data(), static_cast<int>(mesh.getVertexCount()),
+                               mesh.indices.data(), static_cast<int>(mesh.indices.size()));
+}
@@ -9,6 +9,8 @@
 #include <memory>
 #include <map>
 #include "../../models/model.h"
+#include "../../models/mesh_data.h"
+#include "async_loader.h"
 
 struct ModelKey {
     const char* name;
@@ -44,7 +46,9 @@ private:
     ~ModelLoader();
 
 private:
-    const Model* loadModel(const ModelKey& model_key, const float* vertices, const int& vertices_size);
+    // reads the converted .zmesh file, or prepares the compiled in arrays with ZPG_EMBED_STATIC_MESHES,
+    // without touching GL. The returned upload fills the model in.
+    static AsyncLoader::Upload readMesh(const ModelKey& model_key, Model* model);
 public:
     ModelLoader(ModelLoader const&) = delete;
     void operator=(ModelLoader const&) = delete;
@@ -57,6 +61,13 @@ public:
 
     const Model* loadModel(const char* name);
     const Model* loadModel(const ModelKey& model_key);
+    // placeholder model read by an AsyncLoader worker, loads above return it while it is not uploaded yet
+    const Model* requestModel(const char* name);
+    const Model* requestModel(const ModelKey& model_key);
+
+    // GPU ready data of a static mesh, welded and optimized as a triangle list when ENABLE_MESH_OPTIMIZATION
+    // allows it, compressed as VertexFormat::compress says. Needs no GL context, zpg_meshc writes its result out.
+    static EncodedMesh prepareMesh(const char* name, const float* vertices, int total_count, ModelOptions options);
 };
 
 
@@ -5,46 +5,52 @@
 #include "scene_loader.h"
 
 #include <cmath>
+#include <random>
 // loaders
+#include "async_loader.h"
 #include "model_loader.h"
 #include "texture_loader.h"
 #include "asset_loader.h"
 // animation types
 #include "../../models/animations/cubic_bezier.h"
 #include "../../models/animations/linear.h"
+#include "../../models/animations/cubic_chain.h"
 // other
 #include "../../models/animations/centric_model.h"
+#include "../../models/animations/orbital_instanced.h"
 #include "../../rendering/light/point_light.h"
+#include "../../util/profiler.h"
 
-std::unique_ptr<Scene> SceneLoader::loadScene(int* scene_id, GLFWwindow& window_reference, const int& initial_width,
+std::unique_ptr<Scene> SceneLoader::loadScene(int* scene_id, GLFWwindow* window, const int& initial_width,
                                               const int& initial_height) {
+    ZPG_PROFILE_SCOPE("SceneLoader::loadScene");
     // here, a thought has passed, if we ever would want to preload all scenes
     switch (*scene_id) {
         case 0:
-            return loadSceneA(window_reference, initial_width, initial_height);
+            return loadSceneA(window, initial_width, initial_height);
         case 1:
-            return loadSceneB(window_reference, initial_width, initial_height);
+            return loadSceneB(window, initial_width, initial_height);
         case 2:
-            return loadSceneC(window_reference, initial_width, initial_height);
+            return loadSceneC(window, initial_width, initial_height);
         case 3:
-            return loadSceneD(window_reference, initial_width, initial_height);
+            return loadSceneD(window, initial_width, initial_height);
         case 4:
-            return loadSceneE(window_reference, initial_width, initial_height);
+            return loadSceneE(window, initial_width, initial_height);
         case 5:
-            return loadSceneF(window_reference, initial_width, initial_height);
+            return loadSceneF(window, initial_width, initial_height);
         case 6:
-            return loadSceneG(window_reference, initial_width, initial_height);
+            return loadSceneG(window, initial_width, initial_height);
         default:
             *scene_id = 0;
-            return loadSceneA(window_reference, initial_width, initial_height);
+            return loadSceneA(window, initial_width, initial_height);
     }
 }
 
 std::unique_ptr<Scene>
-SceneLoader::loadSceneA(GLFWwindow& window_reference, const int& initial_width, const int& initial_height) {
+SceneLoader::loadSceneA(GLFWwindow* window, const int& initial_width, const int& initial_height) {
     const float height = -4.5;
 
-    std::unique_ptr<Scene> scene = std::make_unique<Scene>(0, window_reference, initial_width, initial_height);
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(0, window, initial_width, initial_height);
 
     auto [skybox_model, skybox_tex] = lazyLoadCubeMap("cube", "skybox", ".jpg");
     auto& skybox = scene->assignSkybox(skybox_model);
@@ -87,8 +93,8 @@ SceneLoader::loadSceneA(GLFWwindow& window_reference, const int& initial_width,
 }
 
 std::unique_ptr<Scene>
-SceneLoader::loadSceneB(GLFWwindow& window_reference, const int& initial_width, const int& initial_height) {
-    std::unique_ptr<Scene> scene = std::make_unique<Scene>(1, window_reference, initial_width, initial_height);
+SceneLoader::loadSceneB(GLFWwindow* window, const int& initial_width, const int& initial_height) {
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(1, window, initial_width, initial_height);
 
     auto light_pos = glm::vec3(0.f, 10.f, 20.f);
     std::shared_ptr<DirectionalLight> light_a = std::make_unique<DirectionalLight>(-light_pos,
@@ -206,8 +212,8 @@ SceneLoader::loadSceneB(GLFWwindow& window_reference, const int& initial_width,
 
 
 std::unique_ptr<Scene>
-SceneLoader::loadSceneC(GLFWwindow& window_reference, const int& initial_width, const int& initial_height) {
-    std::unique_ptr<Scene> scene = std::make_unique<Scene>(2, window_reference, initial_width, initial_height);
+SceneLoader::loadSceneC(GLFWwindow* window, const int& initial_width, const int& initial_height) {
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(2, window, initial_width, initial_height);
     scene->setAmbient(glm::vec3(0.01, 0.01, 0.01));
     auto& sphere_obj = scene->appendObject(lazyLoadModel("sphere"),
                                            glm::vec3(-1.f, 1.f, -1.f), "phong");
@@ -275,10 +281,10 @@ SceneLoader::loadSceneC(GLFWwindow& window_reference, const int& initial_width,
 }
 
 std::unique_ptr<Scene>
-SceneLoader::loadSceneD(GLFWwindow& window_reference, const int& initial_width, const int& initial_height) {
+SceneLoader::loadSceneD(GLFWwindow* window, const int& initial_width, const int& initial_height) {
     glm::vec3 axis = glm::vec3(0.0f, 1.0f, 0.0f);
 
-    std::unique_ptr<Scene> scene = std::make_unique<Scene>(2, window_reference, initial_width, initial_height);
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(2, window, initial_width, initial_height);
     auto [skybox_model, skybox_tex] = lazyLoadCubeMap("cube", "skybox_space", ".png");
     auto& skybox = scene->assignSkybox(skybox_model);
     skybox.assignTexture(skybox_tex);
@@ -418,25 +424,31 @@ SceneLoader::loadSceneD(GLFWwindow& window_reference, const int& initial_width,
     //
     // Asteroid belt
     //
+    // evaluated on the GPU, the whole belt is a single draw call
     int num_asteroids = 1000;
     float asteroid_belt_radius = 40.f;
     float asteroid_belt_scale = 0.05f;
     float asteroid_belt_speed = 0.01f;
     float asteroid_belt_y_randomness = 2.5f;
+    auto asteroid_obj = scene->draftObject(lazyLoadModel("sphere"),
+                                           glm::vec3(0.f, 0.f, 0.f), "orbital");
+    asteroid_obj->setAmbient(glm::vec3(0.5, 0.5, 0.5));
+    asteroid_obj->setModelParent(sun_composite->getDrawableObject());
+    auto asteroid_belt = std::make_unique<OrbitalInstanced>(std::move(asteroid_obj));
     for (int i = 0; i < num_asteroids; i++) {
-        float angle = (float) i / (float) num_asteroids * 2.f * M_PI;
-        float x = asteroid_belt_radius * std::cos(angle);
-        float z = asteroid_belt_radius * std::sin(angle);
+        // x = r * cos(angle), z = r * sin(angle) is a rotation by -angle around the y axis
+        float angle = (float) i / (float) num_asteroids * 360.f;
         float y = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * (asteroid_belt_y_randomness) -
                   (asteroid_belt_y_randomness / 2.f);
-        auto asteroid_obj = scene->draftObject(lazyLoadModel("sphere"),
-                                               glm::vec3(x, y, z), "constant", axis);
-        asteroid_obj->setAmbient(glm::vec3(0.5, 0.5, 0.5));
-        asteroid_obj->setScale(glm::vec3(asteroid_belt_scale, asteroid_belt_scale, asteroid_belt_scale));
-        auto asteroid_leaf = std::make_unique<CentricModelLeaf>(std::move(asteroid_obj));
-        asteroid_leaf->setMultiplier(static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * asteroid_belt_speed);
-        sun_composite->addModel(std::move(asteroid_leaf));
+        asteroid_belt->addInstance(OrbitalInstance{
+                .radius = asteroid_belt_radius,
+                .phase = -angle,
+                .speed = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * asteroid_belt_speed,
+                .scale = asteroid_belt_scale,
+                .height = y,
+        });
     }
+    scene->appendAnimation(std::move(asteroid_belt));
 
     // building
     scene->appendAnimation(std::move(sun_composite));
@@ -444,8 +456,8 @@ SceneLoader::loadSceneD(GLFWwindow& window_reference, const int& initial_width,
 }
 
 std::unique_ptr<Scene>
-SceneLoader::loadSceneE(GLFWwindow& window_reference, const int& initial_width, const int& initial_height) {
-    std::unique_ptr<Scene> scene = std::make_unique<Scene>(2, window_reference, initial_width, initial_height);
+SceneLoader::loadSceneE(GLFWwindow* window, const int& initial_width, const int& initial_height) {
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(2, window, initial_width, initial_height);
     auto [skybox_model, skybox_tex] = lazyLoadCubeMap("cube", "skybox_space", ".jpg");
     auto& skybox = scene->assignSkybox(skybox_model);
     skybox.assignTexture(skybox_tex);
@@ -558,8 +570,8 @@ SceneLoader::loadSceneE(GLFWwindow& window_reference, const int& initial_width,
 }
 
 std::unique_ptr<Scene>
-SceneLoader::loadSceneF(GLFWwindow& window_reference, const int& initial_width, const int& initial_height) {
-    std::unique_ptr<Scene> scene = std::make_unique<Scene>(1, window_reference, initial_width, initial_height);
+SceneLoader::loadSceneF(GLFWwindow* window, const int& initial_width, const int& initial_height) {
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(1, window, initial_width, initial_height);
     auto& sphere_south_object = scene->appendObject(lazyLoadModel("sphere"),
                                                     glm::vec3(0.f, 0.f, -2.f), "phong");
     sphere_south_object.setProperties(glm::vec3(0.2, 0.0, 0.0),
@@ -578,8 +590,8 @@ SceneLoader::loadSceneF(GLFWwindow& window_reference, const int& initial_width,
 }
 
 std::unique_ptr<Scene>
-SceneLoader::loadSceneG(GLFWwindow& window_reference, const int& initial_width, const int& initial_height) {
-    std::unique_ptr<Scene> scene = std::make_unique<Scene>(1, window_reference, initial_width, initial_height);
+SceneLoader::loadSceneG(GLFWwindow* window, const int& initial_width, const int& initial_height) {
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(1, window, initial_width, initial_height);
     auto& sphere_south_object = scene->appendObject(lazyLoadModel("sphere"),
                                                     glm::vec3(0.f, 0.f, -2.f), "phong_creep");
     sphere_south_object.setProperties(glm::vec3(0.2, 0.0, 0.0),
@@ -597,30 +609,188 @@ SceneLoader::loadSceneG(GLFWwindow& window_reference, const int& initial_width,
     return std::move(scene);
 }
 
+std::unique_ptr<Scene>
+SceneLoader::loadStressScene(const StressSceneConfig& config, GLFWwindow* window, const int& initial_width,
+                             const int& initial_height) {
+    ZPG_PROFILE_SCOPE("SceneLoader::loadStressScene");
+    std::unique_ptr<Scene> scene = std::make_unique<Scene>(STRESS_SCENE_ID, window, initial_width, initial_height);
+    scene->setAmbient(glm::vec3(0.05f, 0.05f, 0.05f));
+
+    // std distributions differ between standard libraries, mt19937 itself does not
+    std::mt19937 rng(config.seed);
+    auto random = [&rng]() { return static_cast<float>(rng() >> 8) / static_cast<float>(1u << 24); };
+    auto randomPosition = [&](float y) {
+        return glm::vec3((random() - 0.5f) * config.extent, y, (random() - 0.5f) * config.extent);
+    };
+    auto randomColor = [&]() { return glm::vec3(random(), random(), random()); };
+
+    const char* models[] = {"sphere", "tree", "bushes", "gift", "suzi_flat", "suzi_smooth"};
+    const char* shaders[] = {"phong", "blinn", "lambert"};
+    constexpr int model_count = sizeof(models) / sizeof(models[0]);
+    constexpr int shader_count = sizeof(shaders) / sizeof(shaders[0]);
+
+    //
+    // Static objects
+    //
+    for (int i = 0; i < config.static_objects; i++) {
+        glm::vec3 position = randomPosition(0.f);
+        float rotation = random() * 360.f;
+
+        if (random() < config.textured_fraction) {
+            auto [square_model, square_tex] = lazyLoadModel("square_uv", "wood.png");
+            auto [zombie_model, zombie_mat, zombie_tex] = lazyLoadAssetModel("zombie.obj", "zombie.png");
+            bool is_zombie = random() < 0.5f;
+
+            auto& object = scene->appendObject(is_zombie ? zombie_model : square_model, position, "phong_tex");
+            object.assignTexture(is_zombie ? zombie_tex : square_tex);
+            object.setProperties(randomColor(), glm::vec3(1.0, 1.0, 1.0), 32.f);
+            object.rotate(glm::vec3(0.f, rotation, 0.f));
+        } else {
+            const char* model = models[rng() % model_count];
+            const char* shader = shaders[rng() % shader_count];
+
+            auto& object = scene->appendObject(lazyLoadModel(model), position, shader);
+            object.setProperties(randomColor(), glm::vec3(1.0, 1.0, 1.0), 8.f + random() * 56.f);
+            object.rotate(glm::vec3(0.f, rotation, 0.f));
+        }
+    }
+
+    //
+    // Lights
+    //
+    const float light_height = 5.0f;
+    for (int i = 0; i < config.point_lights; i++) {
+        std::shared_ptr<PointLight> light = std::make_shared<PointLight>(randomPosition(light_height),
+                                                                         randomColor(),
+                                                                         1.f,
+                                                                         1.f, 0.1f, 0.01f);
+        scene->appendLight(light);
+    }
+    for (int i = 0; i < config.spotlights; i++) {
+        glm::vec3 position = randomPosition(light_height);
+        glm::vec3 target = randomPosition(0.f);
+        std::shared_ptr<Spotlight> light = std::make_shared<Spotlight>(position,
+                                                                       target - position,
+                                                                       randomColor(),
+                                                                       10.f,
+                                                                       1, 0.01, 0.1,
+                                                                       std::cos(glm::radians(12.5f)),
+                                                                       std::cos(glm::radians(17.5f)));
+        scene->appendLight(light);
+    }
+    for (int i = 0; i < config.directional_lights; i++) {
+        glm::vec3 direction = glm::vec3(random() - 0.5f, -1.f, random() - 0.5f);
+        std::shared_ptr<DirectionalLight> light = std::make_shared<DirectionalLight>(direction,
+                                                                                     randomColor(),
+                                                                                     0.25f);
+        scene->appendLight(light);
+    }
+
+    //
+    // Animations
+    //
+    for (int i = 0; i < config.linear_animations; i++) {
+        auto object = scene->draftObject(lazyLoadModel("sphere"), glm::vec3(0.f, 0.f, 0.f), "phong");
+        object->setProperties(randomColor(), glm::vec3(1.0, 1.0, 1.0), 32.f);
+        glm::vec3 direction = glm::vec3(random() - 0.5f, random() * 0.25f, random() - 0.5f);
+        scene->appendAnimation(std::make_unique<Linear>(std::move(object),
+                                                        randomPosition(1.f),
+                                                        direction,
+                                                        10.f, .015f, AnimationArgs::CYCLE));
+    }
+    for (int i = 0; i < config.bezier_animations; i++) {
+        auto object = scene->draftObject(lazyLoadModel("sphere"), glm::vec3(0.f, 0.f, 0.f), "blinn");
+        object->setProperties(randomColor(), glm::vec3(1.0, 1.0, 1.0), 32.f);
+        glm::mat4x3 points = glm::mat4x3(randomPosition(1.f), randomPosition(10.f),
+                                         randomPosition(10.f), randomPosition(1.f));
+        scene->appendAnimation(std::make_unique<CubicBezier>(std::move(object), points,
+                                                             .0008f, AnimationArgs::CYCLE));
+    }
+    for (int i = 0; i < config.chain_animations; i++) {
+        auto object = scene->draftObject(lazyLoadModel("sphere"), randomPosition(1.f), "blinn");
+        object->setProperties(randomColor(), glm::vec3(1.0, 1.0, 1.0), 32.f);
+        auto chain = std::make_unique<CubicChain>(std::move(object), .001f, AnimationArgs::RESTART);
+        for (int segment = 0; segment < 3; segment++) {
+            chain->addControlPoint(glm::mat3x3(randomPosition(5.f), randomPosition(5.f), randomPosition(1.f)));
+        }
+        scene->appendAnimation(std::move(chain));
+    }
+    for (int i = 0; i < config.centric_animations; i++) {
+        auto root = draftCentric(*scene, 0, config, randomPosition(5.f));
+        scene->appendAnimation(std::move(root));
+    }
+
+    return std::move(scene);
+}
+
+std::unique_ptr<CentricModelComponent>
+SceneLoader::draftCentric(Scene& scene, int level, const StressSceneConfig& config, const glm::vec3& offset) {
+    // roots are placed in the world, children relative to their parent
+    const float scale = std::pow(0.5f, static_cast<float>(level));
+    auto object = level == 0
+                  ? scene.draftObject(lazyLoadModel("sphere"), offset, "blinn")
+                  : scene.draftObject(lazyLoadModel("sphere"), offset, "blinn", glm::vec3(0.0f, 1.0f, 0.0f));
+    object->setProperties(glm::vec3(0.6, 0.6, 0.6), glm::vec3(1.0, 1.0, 1.0), 32.f);
+    object->setScale(glm::vec3(scale, scale, scale));
+    // deeper levels orbit slower, the root spins at the default rate
+    const float multiplier = level == 0 ? 1.f : 0.5f / static_cast<float>(level);
+
+    if (level == config.centric_depth) {
+        auto leaf = std::make_unique<CentricModelLeaf>(std::move(object));
+        leaf->setMultiplier(multiplier);
+        return leaf;
+    }
+
+    auto composite = std::make_unique<CentricComposite>(std::move(object));
+    composite->setMultiplier(multiplier);
+    const float orbit = 8.f * scale;
+    for (int i = 0; i < config.centric_branching; i++) {
+        // spread the children around the parent
+        float angle = glm::radians(360.f) * static_cast<float>(i) / static_cast<float>(config.centric_branching);
+        glm::vec3 child_offset = glm::vec3(std::cos(angle) * orbit, 0.f, std::sin(angle) * orbit);
+        composite->addModel(draftCentric(scene, level + 1, config, child_offset));
+    }
+    return composite;
+}
+
 const Model* SceneLoader::lazyLoadModel(const char* name) {
+    if (AsyncLoader::getInstance().isEnabled())
+        return ModelLoader::getInstance().requestModel(name);
     return ModelLoader::getInstance().loadModel(name);
 }
 
 std::pair<const Model*, const Texture*>
 SceneLoader::lazyLoadModel(const char* name, const char* texture_name) {
-    const Model* m = ModelLoader::getInstance().loadModel(ModelKey{name,
-                                                                   static_cast<ModelOptions>(ModelOptions::VERTICES |
-                                                                                             ModelOptions::NORMALS |
-                                                                                             ModelOptions::TEXTURED_UV)});
+    ModelKey key{name, static_cast<ModelOptions>(ModelOptions::VERTICES |
+                                                 ModelOptions::NORMALS |
+                                                 ModelOptions::TEXTURED_UV)};
+    if (AsyncLoader::getInstance().isEnabled())
+        return std::make_pair(ModelLoader::getInstance().requestModel(key),
+                              TextureLoader::getInstance().requestTexture(texture_name));
+    const Model* m = ModelLoader::getInstance().loadModel(key);
     const Texture* t = TextureLoader::getInstance().loadTexture(texture_name);
     return std::make_pair(m, t);
 }
 
 std::pair<const Model*, const Texture*>
 SceneLoader::lazyLoadCubeMap(const char* name, const char* skybox_name, const char* texture_extension) {
-    const Model* m = ModelLoader::getInstance().loadModel(
-            ModelKey{name, static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::SKYBOX)});
+    ModelKey key{name, static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::SKYBOX)};
+    if (AsyncLoader::getInstance().isEnabled())
+        return std::make_pair(ModelLoader::getInstance().requestModel(key),
+                              TextureLoader::getInstance().requestCubeMap(skybox_name, texture_extension));
+    const Model* m = ModelLoader::getInstance().loadModel(key);
     const Texture* t = TextureLoader::getInstance().loadCubeMap(skybox_name, texture_extension);
     return std::make_pair(m, t);
 }
 
 std::tuple<const Model*, const Material, const Texture*>
 SceneLoader::lazyLoadAssetModel(const char* obj_name, const char* texture_name) {
+    // an asset still loading has the default material
+    if (AsyncLoader::getInstance().isEnabled()) {
+        const auto* asset = AssetLoader::getInstance().requestAssetModel(obj_name);
+        return std::make_tuple(&asset->model, asset->material,
+                               TextureLoader::getInstance().requestTexture(texture_name));
+    }
     const auto* asset = AssetLoader::getInstance().loadAssetModel(obj_name);
     const Texture* t = TextureLoader::getInstance().loadTexture(texture_name);
     return std::make_tuple(&asset->model, asset->material, t);
@@ -6,7 +6,35 @@
 #define ZPG_SCENE_LOADER_H
 
 
+#include <cstdint>
 #include "../scene.h"
+#include "../../models/animations/centric_model.h"
+
+//
+// Parameters of the generated stress scene, the same seed always produces the same scene.
+//
+struct StressSceneConfig {
+    uint32_t seed = 0;
+    // objects are scattered over an extent x extent square around the origin
+    float extent = 100.f;
+
+    int static_objects = 1000;
+    // share of the static objects using a textured model
+    float textured_fraction = 0.25f;
+
+    int point_lights = 16;
+    int spotlights = 4;
+    // capped at DIRECTIONAL_CONFIG.max_count by the light manager
+    int directional_lights = 1;
+
+    int linear_animations = 8;
+    int bezier_animations = 8;
+    int chain_animations = 8;
+    int centric_animations = 2;
+    // levels below the root of every centric hierarchy, each node has centric_branching children
+    int centric_depth = 3;
+    int centric_branching = 2;
+};
 
 class SceneLoader {
 public:
@@ -15,33 +43,47 @@ public:
     void operator=(SceneLoader const&) = delete;
     ~SceneLoader() = delete;
 
+    // loadSceneA .. loadSceneG, out of range ids fall back to the first scene
+    static constexpr int SCENE_COUNT = 7;
+    // id reported by the generated stress scene
+    static constexpr char STRESS_SCENE_ID = SCENE_COUNT;
+
     static std::unique_ptr<Scene>
-    loadScene(int* scene_id, GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadScene(int* scene_id, GLFWwindow* window, const int& initial_width, const int& initial_height);
+    static std::unique_ptr<Scene>
+    loadStressScene(const StressSceneConfig& config, GLFWwindow* window, const int& initial_width,
+                    const int& initial_height);
 
 private:
     static std::unique_ptr<Scene>
-    loadSceneA(GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadSceneA(GLFWwindow* window, const int& initial_width, const int& initial_height);
     static std::unique_ptr<Scene>
-    loadSceneB(GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadSceneB(GLFWwindow* window, const int& initial_width, const int& initial_height);
     static std::unique_ptr<Scene>
-    loadSceneC(GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadSceneC(GLFWwindow* window, const int& initial_width, const int& initial_height);
     static std::unique_ptr<Scene>
-    loadSceneD(GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadSceneD(GLFWwindow* window, const int& initial_width, const int& initial_height);
     static std::unique_ptr<Scene>
-    loadSceneE(GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadSceneE(GLFWwindow* window, const int& initial_width, const int& initial_height);
     static std::unique_ptr<Scene>
-    loadSceneF(GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadSceneF(GLFWwindow* window, const int& initial_width, const int& initial_height);
     static std::unique_ptr<Scene>
-    loadSceneG(GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    loadSceneG(GLFWwindow* window, const int& initial_width, const int& initial_height);
+
+    // centric hierarchy below a node at the given level, orbits shrink with every level
+    static std::unique_ptr<CentricModelComponent>
+    draftCentric(Scene& scene, int level, const StressSceneConfig& config, const glm::vec3& offset);
 
     //
     // Facade functions for loading models and textures
+    // with AsyncLoader enabled they return placeholders and the assets load in the background
     //
     static const Model* lazyLoadModel(const char* name);
     static std::pair<const Model*, const Texture*> lazyLoadModel(const char* name, const char* texture_name);
     static std::pair<const Model*, const Texture*> lazyLoadCubeMap(const char* name, const char* skybox_name,
                                                                  const char* texture_extension);
 
+    // the material is a copy, an asset loading in the background yields the default one
     static std::tuple<const Model*, const Material, const Texture*> lazyLoadAssetModel(const char* obj_name, const char* texture_name);
 };
 
@@ -0,0 +1,46 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <cstring>
+#include "static_meshes.h"
+
+#include "../../../assets/static/bushes.h"
+#include "../../../assets/static/gift.h"
+#include "../../../assets/static/plain.h"
+#include "../../../assets/static/sphere.h"
+#include "../../../assets/static/suzi_flat.h"
+#include "../../../assets/static/suzi_smooth.h"
+#include "../../../assets/static/tree.h"
+#include "../../../assets/static/square_uv.h"
+#include "../../../assets/static/cube.h"
+
+namespace {
+    constexpr auto POSITIONS_NORMALS = static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::NORMALS);
+
+    const StaticMesh STATIC_MESHES[] = {
+            {"bushes", bushes, sizeof(bushes), POSITIONS_NORMALS},
+            {"gift", gift, sizeof(gift), POSITIONS_NORMALS},
+            {"plain", plain, sizeof(plain), POSITIONS_NORMALS},
+            {"sphere", sphere, sizeof(sphere), POSITIONS_NORMALS},
+            {"suzi_flat", suziFlat, sizeof(suziFlat), POSITIONS_NORMALS},
+            {"suzi_smooth", suziSmooth, sizeof(suziSmooth), POSITIONS_NORMALS},
+            {"tree", tree, sizeof(tree), POSITIONS_NORMALS},
+            {"square_uv", square_uv, sizeof(square_uv),
+             static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::NORMALS | ModelOptions::TEXTURED_UV)},
+            {"cube", skycube, sizeof(skycube), static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::SKYBOX)},
+            {nullptr, nullptr, 0, ModelOptions::UNKNOWN},
+    };
+}
+
+const StaticMesh* StaticMeshes::getAll() {
+    return STATIC_MESHES;
+}
+
+const StaticMesh* StaticMeshes::find(const char* name) {
+    for (const StaticMesh* mesh = STATIC_MESHES; mesh->name != nullptr; mesh++) {
+        if (strcmp(mesh->name, name) == 0)
+            return mesh;
+    }
+    return nullptr;
+}
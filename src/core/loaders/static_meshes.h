@@ -0,0 +1,34 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_STATIC_MESHES_H
+#define ZPG_STATIC_MESHES_H
+
+#include <cstddef>
+#include "../../models/model.h"
+
+// a float array of assets/static
+struct StaticMesh {
+    const char* name;
+    const float* vertices;
+    size_t size; // bytes
+    // the layout of the array
+    ModelOptions options;
+};
+
+//
+// The meshes compiled from assets/static. Only the converter (tools/zpg_meshc.cpp) and builds with
+// ZPG_EMBED_STATIC_MESHES compile static_meshes.cpp, everything else loads the converted .zmesh files,
+// so the headers stay out of the application binary.
+//
+class StaticMeshes {
+public:
+    // null terminated
+    static const StaticMesh* getAll();
+    // null when the name is unknown
+    static const StaticMesh* find(const char* name);
+};
+
+
+#endif //ZPG_STATIC_MESHES_H
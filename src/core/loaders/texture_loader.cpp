@@ -5,7 +5,79 @@
 #include "texture_loader.h"
 #include <SOIL/SOIL.h>
 #include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
 #include <stdexcept>
+#include <vector>
+#include "async_loader.h"
+#include "../../util/profiler.h"
+
+namespace {
+    // RGBA pixels decoded on a worker, freed once uploaded
+    struct Image {
+        int width = 0;
+        int height = 0;
+        unsigned char* pixels = nullptr;
+
+        Image() = default;
+        Image(const Image&) = delete;
+        Image& operator=(const Image&) = delete;
+        ~Image() {
+            if (pixels != nullptr)
+                SOIL_free_image_data(pixels);
+        }
+    };
+
+    struct CubeMapFaces {
+        std::array<Image, 6> faces;
+        // faces still decoding, the worker finishing the last one hands all of them to the upload
+        std::atomic<int> remaining{6};
+    };
+
+    // px, nx, py, ny, pz, nz, the order of the GL_TEXTURE_CUBE_MAP_POSITIVE_X + i faces
+    std::array<std::string, 6> getCubeMapPaths(const char* name, const char* extension) {
+        std::string path = std::string(ASSETS_PATH) + name + "/";
+        return {path + "px" + extension, path + "nx" + extension,
+                path + "py" + extension, path + "ny" + extension,
+                path + "pz" + extension, path + "nz" + extension};
+    }
+
+    void decode(const std::string& path, Image& image, bool invert_y) {
+        int channels;
+        image.pixels = SOIL_load_image(path.c_str(), &image.width, &image.height, &channels, SOIL_LOAD_RGBA);
+        if (image.pixels == nullptr)
+            throw std::runtime_error("TextureLoader::decode: Failed to load image: " + path);
+        if (!invert_y)
+            return;
+
+        // what SOIL_FLAG_INVERT_Y does for the synchronous loads
+        const size_t row = static_cast<size_t>(image.width) * 4;
+        std::vector<unsigned char> swap(row);
+        for (int y = 0; y < image.height / 2; y++) {
+            unsigned char* top = image.pixels + y * row;
+            unsigned char* bottom = image.pixels + (image.height - 1 - y) * row;
+            std::memcpy(swap.data(), top, row);
+            std::memcpy(top, bottom, row);
+            std::memcpy(bottom, swap.data(), row);
+        }
+    }
+
+    // single texel texture, or cube map with single texel faces, shown until the real one is uploaded
+    TEXTURE_ID createPlaceholder(TEXTURE_TARGET target) {
+        TEXTURE_ID id;
+        glGenTextures(1, &id);
+        glBindTexture(target, id);
+        if (target == GL_TEXTURE_CUBE_MAP) {
+            for (GLenum face = 0; face < 6; face++)
+                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                             PLACEHOLDER_TEXEL);
+        } else {
+            glTexImage2D(target, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER_TEXEL);
+        }
+        return id;
+    }
+}
 
 TextureLoader::~TextureLoader() {
     for (auto const& texture: texture_repository) {
@@ -18,6 +90,7 @@ const Texture* TextureLoader::loadTexture(const char* name) {
     std::string path = std::string(ASSETS_PATH) + name;
     auto it = texture_repository.find(name);
     if (it == texture_repository.end()) {
+        ZPG_PROFILE_SCOPE("TextureLoader::loadTexture");
         TEXTURE_ID tex_id = SOIL_load_OGL_texture(path.c_str(),
                                                   SOIL_LOAD_RGBA, SOIL_CREATE_NEW_ID, SOIL_FLAG_INVERT_Y);
         if (tex_id == 0) {
@@ -35,15 +108,8 @@ const Texture* TextureLoader::loadTexture(const char* name) {
 }
 
 const Texture* TextureLoader::loadCubeMap(const char* name, const char* extension) {
-    std::string path = std::string(ASSETS_PATH) + name + "/";
-    std::array<std::string, 6> skybox_texture_names = {
-            path + "px" + extension,
-            path + "nx" + extension,
-            path + "py" + extension,
-            path + "ny" + extension,
-            path + "pz" + extension,
-            path + "nz" + extension
-    };
+    ZPG_PROFILE_SCOPE("TextureLoader::loadCubeMap");
+    std::array<std::string, 6> skybox_texture_names = getCubeMapPaths(name, extension);
     auto it = texture_repository.find(name);
     if (it == texture_repository.end()) {
         TEXTURE_ID tex_id = SOIL_load_OGL_cubemap(
@@ -52,7 +118,8 @@ const Texture* TextureLoader::loadCubeMap(const char* name, const char* extensio
                 skybox_texture_names[4].c_str(), skybox_texture_names[5].c_str(),
                 SOIL_LOAD_RGBA, SOIL_CREATE_NEW_ID, 0);
         if (tex_id == 0) {
-            throw std::runtime_error("TextureLoader::loadCubeMap: Failed to load cube map at: " + path);
+            throw std::runtime_error("TextureLoader::loadCubeMap: Failed to load cube map at: "
+                                     + std::string(ASSETS_PATH) + name);
         }
         auto* tex = new Texture(tex_id, GL_TEXTURE0, GL_TEXTURE_CUBE_MAP);
         auto in = texture_repository.insert(std::pair<std::string, Texture*>(name, tex));
@@ -64,3 +131,55 @@ const Texture* TextureLoader::loadCubeMap(const char* name, const char* extensio
     }
     return it->second;
 }
+
+const Texture* TextureLoader::requestTexture(const char* name) {
+    auto it = texture_repository.find(name);
+    if (it != texture_repository.end())
+        return it->second;
+
+    auto* tex = new Texture(createPlaceholder(GL_TEXTURE_2D));
+    texture_repository[name] = tex;
+
+    std::string path = std::string(ASSETS_PATH) + name;
+    AsyncLoader::getInstance().submit(name, [tex, path]() -> AsyncLoader::Upload {
+        auto image = std::make_shared<Image>();
+        decode(path, *image, true);
+        return [tex, image] {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, tex->getTextureId());
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image->width, image->height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         image->pixels);
+        };
+    });
+    return tex;
+}
+
+const Texture* TextureLoader::requestCubeMap(const char* name, const char* extension) {
+    auto it = texture_repository.find(name);
+    if (it != texture_repository.end())
+        return it->second;
+
+    auto* tex = new Texture(createPlaceholder(GL_TEXTURE_CUBE_MAP), GL_TEXTURE0, GL_TEXTURE_CUBE_MAP);
+    texture_repository[name] = tex;
+
+    auto cube_map = std::make_shared<CubeMapFaces>();
+    std::array<std::string, 6> paths = getCubeMapPaths(name, extension);
+    for (int face = 0; face < 6; face++) {
+        const std::string& path = paths[face];
+        AsyncLoader::getInstance().submit(path, [tex, cube_map, face, path]() -> AsyncLoader::Upload {
+            decode(path, cube_map->faces[face], false);
+            if (--cube_map->remaining > 0)
+                return nullptr;
+            return [tex, cube_map] {
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_CUBE_MAP, tex->getTextureId());
+                for (GLenum i = 0; i < 6; i++) {
+                    const Image& image = cube_map->faces[i];
+                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, image.width, image.height, 0,
+                                 GL_RGBA, GL_UNSIGNED_BYTE, image.pixels);
+                }
+            };
+        });
+    }
+    return tex;
+}
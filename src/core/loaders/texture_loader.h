@@ -30,6 +30,11 @@ public:
 
     const Texture* loadTexture(const char* name);
     const Texture* loadCubeMap(const char* name, const char* extension);
+
+    // placeholder textures decoded by AsyncLoader workers and uploaded into the same texture name later,
+    // the faces of a cube map are decoded in parallel. Loads above return the placeholder while it loads.
+    const Texture* requestTexture(const char* name);
+    const Texture* requestCubeMap(const char* name, const char* extension);
 };
 
 #endif //ZPG_TEXTURE_LOADER_H
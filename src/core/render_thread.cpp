@@ -0,0 +1,118 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include "render_thread.h"
+#include "../util/profiler.h"
+#include "../util/render_stats.h"
+
+RenderThread::RenderThread(RenderContext context, std::function<void(const FrameSnapshot&)> render) :
+        context(std::move(context)), render(std::move(render)) {
+    thread = std::thread(&RenderThread::loop, this);
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::loop() {
+    context.bind();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        // tasks go first, the simulation thread is blocked on them
+        if (!tasks.empty() && tasks.front()->frame <= drawn) {
+            Task* task = tasks.front();
+            tasks.pop_front();
+            lock.unlock();
+            {
+                ZPG_PROFILE_SCOPE("RenderThread::invoke");
+                task->fn();
+            }
+            lock.lock();
+            task->done = true;
+            cv.notify_all();
+            continue;
+        }
+
+        // a frame is drawn only once the previous one is on screen
+        if (drawn < submitted && drawn == presented) {
+            const FrameSnapshot& snapshot = snapshots[drawn % snapshots.size()];
+            lock.unlock();
+            {
+                ZPG_PROFILE_SCOPE("RenderThread::render");
+                render(snapshot);
+            }
+            lock.lock();
+            drawn++;
+            cv.notify_all();
+            continue;
+        }
+
+        // events polled after the frame may still read its buffers back, wait for them before swapping
+        if (presented < drawn && presented < closed) {
+            lock.unlock();
+            {
+                ZPG_PROFILE_SCOPE("RenderThread::present");
+                context.present();
+            }
+            // the frame's GL calls were all counted on this thread
+            RenderStats::endFrame();
+            lock.lock();
+            presented++;
+            cv.notify_all();
+            continue;
+        }
+
+        if (stopping && tasks.empty() && presented == submitted)
+            break;
+        cv.wait(lock);
+    }
+    lock.unlock();
+
+    context.release();
+}
+
+FrameSnapshot& RenderThread::acquire() {
+    ZPG_PROFILE_SCOPE("RenderThread::acquire");
+    std::unique_lock<std::mutex> lock(mutex);
+    // the slot is free once the frame drawn from it two submissions ago is presented
+    cv.wait(lock, [this] { return presented + 1 >= submitted; });
+    FrameSnapshot& snapshot = snapshots[submitted % snapshots.size()];
+    snapshot.clear();
+    return snapshot;
+}
+
+void RenderThread::submit() {
+    std::lock_guard<std::mutex> lock(mutex);
+    submitted++;
+    cv.notify_all();
+}
+
+void RenderThread::closeFrame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = submitted;
+    cv.notify_all();
+}
+
+void RenderThread::invoke(const std::function<void()>& fn) {
+    ZPG_PROFILE_SCOPE("RenderThread::wait");
+    std::unique_lock<std::mutex> lock(mutex);
+    Task task{fn, submitted};
+    tasks.push_back(&task);
+    cv.notify_all();
+    cv.wait(lock, [&task] { return task.done; });
+}
+
+void RenderThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping)
+            return;
+        stopping = true;
+        closed = submitted;
+        cv.notify_all();
+    }
+    if (thread.joinable())
+        thread.join();
+}
@@ -0,0 +1,78 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_RENDER_THREAD_H
+#define ZPG_RENDER_THREAD_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "../rendering/frame_snapshot.h"
+
+// how the GL context of the window (or the headless surface) changes hands
+struct RenderContext {
+    std::function<void()> bind;
+    std::function<void()> release;
+    // swap buffers, a no-op without a window
+    std::function<void()> present;
+};
+
+//
+// Owns the GL context while a scene runs and draws the snapshots the simulation thread submits.
+// Two snapshot slots are used: the simulation fills one while the other is drawn,
+// so it runs at most one frame ahead and never waits for the GPU unless it gets two frames ahead.
+// Work that needs the context on the simulation side (shader attach, picking readbacks, batch uploads)
+// goes through invoke(), which runs it between two frames after the last submitted frame is drawn.
+//
+class RenderThread {
+private:
+    RenderContext context;
+    std::function<void(const FrameSnapshot&)> render;
+    std::array<FrameSnapshot, 2> snapshots;
+
+    struct Task {
+        std::function<void()> fn;
+        // frames that have to be drawn first, the task sees the scene they were built from
+        uint64_t frame;
+        bool done = false;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Task*> tasks;
+    // frame counters, drawn and presented trail submitted by at most one frame
+    uint64_t submitted = 0;
+    uint64_t drawn = 0;
+    uint64_t closed = 0;
+    uint64_t presented = 0;
+    bool stopping = false;
+
+    std::thread thread;
+private:
+    void loop();
+public:
+    RenderThread(RenderContext context, std::function<void(const FrameSnapshot&)> render);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // free snapshot slot for the next frame, waits while the render thread is a full frame behind
+    FrameSnapshot& acquire();
+    // hand the acquired snapshot over for drawing
+    void submit();
+    // input of the submitted frame is handled, it may be presented
+    void closeFrame();
+    // run on the render thread with the context current, blocks until it is done
+    void invoke(const std::function<void()>& fn);
+    // draws and presents everything submitted, then releases the context
+    void stop();
+};
+
+
+#endif //ZPG_RENDER_THREAD_H
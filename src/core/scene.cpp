@@ -18,16 +18,20 @@
 #include "glm/gtc/type_ptr.hpp" // glm::value_ptr
 
 #include "scene.h"
+#include "loaders/async_loader.h"
 #include "loaders/model_loader.h"
+#include "../util/profiler.h"
+#include "../util/render_stats.h"
 
-Scene::Scene(const char& id, GLFWwindow& window_reference, const int& initial_width, const int& initial_height) :
-        scene_id(id), window(&window_reference) {
+Scene::Scene(const char& id, GLFWwindow* window, const int& initial_width, const int& initial_height) :
+        scene_id(id), window(window) {
     this->camera = std::make_unique<Camera>(initial_width, initial_height);
     this->object_manager = std::make_unique<ObjectManager>();
     this->animation_manager = std::make_unique<AnimationManager>();
 }
 
 void Scene::init(std::shared_ptr<ShaderLoader> preloaded_shader_loader) {
+    ZPG_PROFILE_SCOPE("Scene::init");
     this->shader_loader = std::move(preloaded_shader_loader);
 
     // create bezier
@@ -50,33 +54,25 @@ void Scene::init(std::shared_ptr<ShaderLoader> preloaded_shader_loader) {
         });
     }
 
-    // subscribe shaders to camera
-    for (auto shader: *this->shader_loader) {
-        camera->attach(shader);
-    }
-
-    // subscribe shaders to light manager
-    for (auto shader: *this->shader_loader) {
-        light_manager.attach(shader);
-    }
+    // camera moves the flashlight, light manager re-packs it
+    camera->attach(&light_manager);
 
     // subscribe single shader to drawable objects inside animations
-    for (const auto animation: *animation_manager) {
-        animation_manager->applyAnimations([this](Animation* animation) {
-            Shader* sh = this->shader_loader->loadShader(animation->getShaderAlias());
-            animation->attachShader(sh);
-            animation->notifyShader();
-        });
-    }
+    animation_manager->applyAnimations([this](Animation* animation) {
+        Shader* sh = this->shader_loader->getShader(animation->getShaderAlias());
+        animation->attachShader(sh);
+        animation->getDrawableObject().setShaderRequirements(sh->getRequirements());
+        render_queue.insert(animation);
+    });
 
     // subscribe single shader to skybox
     if (object_manager->hasSkybox()) {
         auto& skybox = object_manager->getSkybox();
         assignShaderAlias(skybox);
-        Shader* sh = this->shader_loader->loadShader(skybox.getShaderAlias());
+        Shader* sh = this->shader_loader->getShader(skybox.getShaderAlias());
         skybox.attach(sh);
-        skybox.notifyModel();
-        skybox.notifyMaterial();
+        skybox.setShaderRequirements(sh->getRequirements());
+        render_queue.insert(&skybox, RenderPass::SKYBOX);
     }
 
     // create flashlight
@@ -85,13 +81,32 @@ void Scene::init(std::shared_ptr<ShaderLoader> preloaded_shader_loader) {
     auto fl = light_manager.getLight(fl_id);
     this->camera->setFlashlight(std::static_pointer_cast<Spotlight>(fl));
 
-    // pass camera and light uniforms to shaders
+    // pass camera and light uniform blocks to shaders
     camera->start();
-    light_manager.notifyShaders();
+    light_manager.start(*camera);
+
+    if (IndirectRenderer::isSupported())
+        indirect_renderer = std::make_unique<IndirectRenderer>();
 }
 
 void Scene::prepareObjects() {
-    object_manager->preprocess(this->shader_loader.get());
+    // batch uploads need the context, the rest is bookkeeping
+    if (object_manager->hasPendingBatches())
+        onRenderThread([this] { object_manager->preprocess(shader_loader.get(), render_queue); });
+    else
+        object_manager->preprocess(shader_loader.get(), render_queue);
+}
+
+void Scene::uploadAssets() {
+    AsyncLoader& loader = AsyncLoader::getInstance();
+    if (!loader.hasUploads())
+        return;
+
+    size_t uploaded = 0;
+    onRenderThread([&loader, &uploaded] { uploaded = loader.upload(ASYNC_UPLOAD_BUDGET_MS); });
+    // models that were placeholders until now sort by their real VAO
+    if (uploaded > 0)
+        render_queue.updateState();
 }
 
 std::unique_ptr<DrawableObject> Scene::draftObject(
@@ -152,61 +167,211 @@ void Scene::appendLight(const std::shared_ptr<Light>& light) {
 
 
 void Scene::run() {
+    if (render_context != nullptr) {
+        // the render thread takes the context over until the scene finishes
+        render_context->release();
+        render_thread = std::make_unique<RenderThread>(*render_context,
+                                                       [this](const FrameSnapshot& frame_snapshot) {
+                                                           render(frame_snapshot);
+                                                       });
+    }
+
     last_frame_time = (float)glfwGetTime() * FRAME_TIME_MULTIPLIER;
+    int frame_count = 0;
     while (!is_finished) {
-        this->prepareObjects();
+        float delta_time = fixed_time_step * FRAME_TIME_MULTIPLIER;
+        if (fixed_time_step == 0.0f) {
+            auto current_frame_time = (float)glfwGetTime() * FRAME_TIME_MULTIPLIER;
+            delta_time = current_frame_time - last_frame_time;
+            last_frame_time = current_frame_time;
+        }
+
+        if (input != nullptr) {
+            delta_time = input->beginFrame(delta_time);
+            if (input->isFinished()) {
+                finish();
+                break;
+            }
+        }
+
+        frame(delta_time);
 
-        auto current_frame_time = (float)glfwGetTime() * FRAME_TIME_MULTIPLIER;
-        float delta_time = current_frame_time - last_frame_time;
-        last_frame_time = current_frame_time;
+        // update other events like input handling
+        if (window != nullptr) {
+            ZPG_PROFILE_SCOPE("glfwPollEvents");
+            glfwPollEvents();
+        }
+        // replayed events arrive at the same point, before the swap, so picking reads the same depth buffer
+        if (input != nullptr) {
+            ZPG_PROFILE_SCOPE("InputRecorder::dispatch");
+            input->dispatch();
+        }
+        // put the stuff we've been drawing onto the display
+        present();
+
+        if (frame_limit > 0 && ++frame_count >= frame_limit)
+            finish();
+    }
+
+    if (render_thread != nullptr) {
+        render_thread->stop();
+        render_thread.reset();
+        render_context->bind();
+    }
+}
+
+void Scene::frame(float delta_time) {
+    ZPG_PROFILE_SCOPE("Scene::frame");
+    if (render_thread != nullptr) {
+        FrameSnapshot& frame_snapshot = render_thread->acquire();
+        simulate(delta_time, frame_snapshot);
+        render_thread->submit();
+        return;
+    }
+
+    snapshot.clear();
+    simulate(delta_time, snapshot);
+    render(snapshot);
+}
+
+void Scene::present() {
+    if (render_thread != nullptr) {
+        render_thread->closeFrame();
+        return;
+    }
 
+    if (window != nullptr) {
+        ZPG_PROFILE_SCOPE("glfwSwapBuffers");
+        glfwSwapBuffers(window);
+    }
+    RenderStats::endFrame();
+}
+
+void Scene::onRenderThread(const std::function<void()>& task) {
+    if (render_thread != nullptr)
+        render_thread->invoke(task);
+    else
+        task();
+}
+
+void Scene::simulate(float delta_time, FrameSnapshot& frame_snapshot) {
+    ZPG_PROFILE_SCOPE("Scene::simulate");
+    {
+        ZPG_PROFILE_SCOPE("Scene::uploadAssets");
+        this->uploadAssets();
+    }
+    {
+        ZPG_PROFILE_SCOPE("Scene::prepareObjects");
+        this->prepareObjects();
+    }
+
+    {
+        ZPG_PROFILE_SCOPE("Scene::updateCamera");
         continuousMovement(delta_time);
         camera->jumpProgress(delta_time);
+        frame_snapshot.camera_dirty = camera->updateBlock();
+        frame_snapshot.camera = camera->getBlock();
+    }
+    // advance animations before their depth is sorted
+    {
+        ZPG_PROFILE_SCOPE("Scene::stepAnimations");
+        animation_manager->stepAnimations(delta_time);
+    }
+    {
+        ZPG_PROFILE_SCOPE("TransformStore::update");
+        TransformStore::get().update();
+    }
+    {
+        ZPG_PROFILE_SCOPE("Scene::cull");
+        render_queue.updateDepth(camera->getPosition());
+        frustum.update(camera->getViewProjection());
+        render_queue.cull(frustum, object_manager->getBVH());
+    }
 
-        // wipe the stencil buffer identifying objects
-        glStencilFunc(GL_ALWAYS, 0, 0xFF);
-        // wipe the drawing surface clear
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        if (const auto& skybox = object_manager->getSkybox(); object_manager->hasSkybox()) {
-            if (CYCLE_CULL_FACE_SKYBOX)
-                glDisable(GL_CULL_FACE);
-            glDisable(GL_DEPTH_TEST);
-            Shader* sh = shader_loader->loadShader(skybox.getShaderAlias());
-            skybox.notifyModelParameters();
-            sh->lazyPassUniforms();
-            skybox.draw();
-            glEnable(GL_DEPTH_TEST);
-            if (CYCLE_CULL_FACE_SKYBOX)
-                glEnable(GL_CULL_FACE);
+    {
+        ZPG_PROFILE_SCOPE("Scene::snapshot");
+        for (const auto& item: render_queue) {
+            if (!item.visible)
+                continue;
+
+            // interactive objects need their own stencil index, they can't share a draw call
+            SHADER_ALIAS_DATATYPE alias = item.getShaderAlias();
+            if (indirect_renderer != nullptr && item.type == RenderItemType::OBJECT && item.getStencilID() == 0) {
+                SHADER_ALIAS_DATATYPE indirect_alias = shader_loader->getIndirectAlias(alias);
+                if (indirect_alias != SHADER_UNLOADED && IndirectRenderer::accepts(*item.object->getModel())) {
+                    frame_snapshot.addIndirect(item, indirect_alias,
+                                               shader_loader->getShader(indirect_alias)->getRequirements(),
+                                               indirect_renderer.get());
+                    continue;
+                }
+            }
+            frame_snapshot.add(item, shader_loader->getShader(alias)->getRequirements());
         }
+    }
+    // lights stay dirty until a lit shader is drawn again
+    if (frame_snapshot.requirements & REQUIRES_LIGHTS) {
+        ZPG_PROFILE_SCOPE("LightManager::prepare");
+        light_manager.prepare(*camera, frame_snapshot.lights);
+    }
+}
 
-        for (const auto object: *object_manager) {
-            Shader* sh = shader_loader->loadShader(object->getShaderAlias());
-            object->notifyModelParameters();
+void Scene::render(const FrameSnapshot& frame_snapshot) {
+    ZPG_PROFILE_SCOPE("Scene::render");
+    {
+        ZPG_PROFILE_SCOPE("Scene::uploadBlocks");
+        if (frame_snapshot.camera_dirty)
+            camera->uploadBlock(frame_snapshot.camera);
+        if (frame_snapshot.requirements & REQUIRES_LIGHTS)
+            light_manager.upload(frame_snapshot.lights);
+        if (indirect_renderer != nullptr)
+            indirect_renderer->upload(frame_snapshot.indirect_models, frame_snapshot.indirect_data);
+    }
+
+    // wipe the stencil buffer identifying objects
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+    RenderStats::counters().stencil_changes++;
+    char stencil_id = 0;
+    // wipe the drawing surface clear
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // skybox, static objects, instanced batches and animations in a single ordered submission
+    {
+        ZPG_PROFILE_SCOPE("Scene::drawQueue");
+        for (const auto& draw: frame_snapshot.draws) {
+            ZPG_PROFILE_SCOPE(draw.getName());
+            if (draw.pass == RenderPass::SKYBOX) {
+                if (CYCLE_CULL_FACE_SKYBOX)
+                    glDisable(GL_CULL_FACE);
+                glDisable(GL_DEPTH_TEST);
+            }
+
+            // interactive objects set their own stencil index, reset it for the rest
+            if (draw.stencil_id != stencil_id) {
+                if (draw.stencil_id == 0) {
+                    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+                    RenderStats::counters().stencil_changes++;
+                }
+                stencil_id = draw.stencil_id;
+            }
+
+            Shader* sh = shader_loader->loadShader(draw.shader_alias);
+            draw.notifyShader(sh);
             sh->lazyPassUniforms();
-            object->draw();
-        }
+            draw.draw();
 
-        // animations
-        for (const auto animation: *animation_manager) {
-            animation_manager->applyAnimations([this, &delta_time](Animation* animation) {
-                const SHADER_ALIAS_DATATYPE current_alias = animation->getShaderAlias();
-                Shader* sh = shader_loader->loadShader(current_alias);
-                animation->step(delta_time);
-                animation->notifyShader();
-                sh->lazyPassUniforms();
-                animation->draw();
-            });
+            if (draw.pass == RenderPass::SKYBOX) {
+                glEnable(GL_DEPTH_TEST);
+                if (CYCLE_CULL_FACE_SKYBOX)
+                    glEnable(GL_CULL_FACE);
+            }
         }
-
-        // update other events like input handling
-        glfwPollEvents();
-        // put the stuff we've been drawing onto the display
-        glfwSwapBuffers(window);
     }
 }
 
 void Scene::handleKeyEventPress(int key, int scancode, int action, int mods) {
+    if (key >= 0 && key <= GLFW_KEY_LAST)
+        pressed_keys[key] = true;
+
     switch (key) {
         case GLFW_MOUSE_BUTTON_RIGHT:
             right_mouse_button_pressed = true;
@@ -280,12 +445,20 @@ void Scene::handleKeyEventPress(int key, int scancode, int action, int mods) {
         case GLFW_KEY_O:
             deleteTargetObject();
             break;
+        case GLFW_KEY_C: {
+            const auto& stats = render_queue.getCullStats();
+            printf("Culling: %zu visible, %zu culled\n", stats.visible, stats.culled);
+            break;
+        }
         default:
             break;
     }
 }
 
-void Scene::handleKeyEventRelease(int key, int scancode, int action, int mods) { }
+void Scene::handleKeyEventRelease(int key, int scancode, int action, int mods) {
+    if (key >= 0 && key <= GLFW_KEY_LAST)
+        pressed_keys[key] = false;
+}
 
 Scene::~Scene() {}
 
@@ -309,13 +482,13 @@ void Scene::handleMouseMovementEvent(double x_pos, double y_pos) {
 }
 
 inline void Scene::continuousMovement(const float& delta_time) {
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+    if (pressed_keys[GLFW_KEY_W])
         camera->moveCharacterFront(CAMERA_SPEED * delta_time);
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+    if (pressed_keys[GLFW_KEY_S])
         camera->moveCharacterFront(-CAMERA_SPEED * delta_time);
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+    if (pressed_keys[GLFW_KEY_A])
         camera->moveCharacterSide(-CAMERA_SPEED * delta_time);
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+    if (pressed_keys[GLFW_KEY_D])
         camera->moveCharacterSide(CAMERA_SPEED * delta_time);
 }
 
@@ -356,9 +529,14 @@ void Scene::handleMouseButtonEventRelease(int button, int action, int mods) {
 }
 
 void Scene::showBuffers(double x_pos, double y_pos) {
-    glm::vec4 color = camera->getColorBuffer(x_pos, y_pos);
-    float depth = camera->getDepthBuffer(x_pos, y_pos);
-    char index = camera->getStencilBuffer(x_pos, y_pos);
+    glm::vec4 color;
+    float depth;
+    char index;
+    onRenderThread([&] {
+        color = camera->getColorBuffer(x_pos, y_pos);
+        depth = camera->getDepthBuffer(x_pos, y_pos);
+        index = camera->getStencilBuffer(x_pos, y_pos);
+    });
     glm::vec3 pos = camera->getWorldPosition(x_pos, y_pos, depth);
 
     printf("Clicked on pixel %f, %f, color (%.0f,%.0f,%.0f,%.0f), depth %f, stencil index %u\n",
@@ -370,8 +548,7 @@ void Scene::handleBezier(double x_pos, double y_pos) {
     if (bezier == nullptr)
         return;
 
-    float depth = camera->getDepthBuffer(x_pos, y_pos);
-    glm::vec3 pos = camera->getWorldPosition(x_pos, y_pos, depth);
+    glm::vec3 pos = pickWorldPosition(x_pos, y_pos);
 
     incomplete_bezier_points.push_back(pos);
 
@@ -389,9 +566,16 @@ void Scene::handleBezier(double x_pos, double y_pos) {
     }
 }
 
+glm::vec3 Scene::pickWorldPosition(double x_pos, double y_pos) {
+    // picking stays on the depth buffer, it holds the exact surface including animations that are not in the BVH,
+    // a ray against the BVH would only hit the object boxes
+    float depth;
+    onRenderThread([&] { depth = camera->getDepthBuffer(x_pos, y_pos); });
+    return camera->getWorldPosition(x_pos, y_pos, depth);
+}
+
 void Scene::handlePlantTree(double x_pos, double y_pos) {
-    float depth = camera->getDepthBuffer(x_pos, y_pos);
-    glm::vec3 pos = camera->getWorldPosition(x_pos, y_pos, depth);
+    glm::vec3 pos = pickWorldPosition(x_pos, y_pos);
 
     plantTree(pos.x, 0, pos.z);
     printf("Tree planted at %f, %f, %f\n", pos.x, 0., pos.z);
@@ -411,7 +595,8 @@ void Scene::plantTree(float x, float y, float z) {
 }
 
 void Scene::deleteTargetObject() {
-    char id = camera->getStencilBuffer(last_mouse_x, last_mouse_y);
+    char id;
+    onRenderThread([&] { id = camera->getStencilBuffer(last_mouse_x, last_mouse_y); });
     if (id != 0) {
         object_manager->deleteByInteractID(id);
         printf("Object with id %d deleted\n", id);
@@ -19,6 +19,8 @@
 #include "glm/gtc/type_ptr.hpp" // glm::value_ptr
 
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <vector>
 #include "../shaders/shader_loader.h"
@@ -28,16 +30,30 @@
 #include "../rendering/light_manager.h"
 #include "../rendering/object_manager.h"
 #include "../rendering/animation_manager.h"
+#include "../rendering/render_queue.h"
+#include "../rendering/frame_snapshot.h"
 #include "../models/animations/cubic_chain.h"
+#include "input_recorder.h"
+#include "render_thread.h"
 
 class Scene {
 private:
     char scene_id;
+    // null when running headless, input is skipped then
     GLFWwindow* window;
     std::shared_ptr<ShaderLoader> shader_loader;
     std::unique_ptr<ObjectManager> object_manager;
     std::unique_ptr<AnimationManager> animation_manager;
     LightManager light_manager;
+    RenderQueue render_queue;
+    Frustum frustum;
+    // null without OpenGL 4.3, objects are then drawn one by one
+    std::unique_ptr<IndirectRenderer> indirect_renderer;
+    // drawn right after simulate() when running without a render thread
+    FrameSnapshot snapshot;
+    // set hands the context to a render thread for the duration of run(), owned by the application
+    const RenderContext* render_context = nullptr;
+    std::unique_ptr<RenderThread> render_thread;
 
     glm::vec3 scene_ambient = AMBIENT_LIGHT;
 
@@ -45,10 +61,19 @@ private:
     const glm::vec3 scene_up = glm::vec3(0.0f, 1.0f, 0.0f);
 
     bool right_mouse_button_pressed = false;
+    // tracked from key events instead of glfwGetKey, so replayed and headless input moves the camera too
+    std::array<bool, GLFW_KEY_LAST + 1> pressed_keys{};
     double last_mouse_x = 0;
     double last_mouse_y = 0;
     float last_frame_time = 0.0f;
 
+    // non-zero replaces the wall clock with a constant step (seconds)
+    float fixed_time_step = 0.0f;
+    // non-zero finishes the scene after this many frames
+    int frame_limit = 0;
+    // records or replays the input of every frame, owned by the application
+    InputRecorder* input = nullptr;
+
     char mode = 't'; // t - tree planting, b - bezier adding
     std::vector<glm::vec3> incomplete_bezier_points;
     CubicChain* bezier;
@@ -58,6 +83,16 @@ private:
     void plantTree(float x, float y, float z);
     void showBuffers(double x_pos, double y_pos);
     void deleteTargetObject();
+    glm::vec3 pickWorldPosition(double x_pos, double y_pos);
+
+    // fill placeholders of assets loaded in the background, within the per-frame budget
+    void uploadAssets();
+    // everything up to culling, fills the snapshot without touching GL
+    void simulate(float delta_time, FrameSnapshot& frame_snapshot);
+    // GL side of a frame, runs on the render thread when there is one
+    void render(const FrameSnapshot& frame_snapshot);
+    // swap (or let the render thread swap) once the input of the frame is handled
+    void present();
 public:
     void setAmbient(const glm::vec3& ambient) { scene_ambient = ambient; }
     void assignShaderAlias(DrawableObject& object);
@@ -79,16 +114,25 @@ public:
 
     DrawableObject& assignSkybox(const Model* model_ptr);
 public:
-    Scene(const char& id, GLFWwindow& window_reference, const int& initial_width, const int& initial_height);
+    Scene(const char& id, GLFWwindow* window, const int& initial_width, const int& initial_height);
     ~Scene();
 
     void init(std::shared_ptr<ShaderLoader> preloaded_shader_loader);
     void prepareObjects();
     void run();
+    // update and draw a single frame, delta_time is already scaled by FRAME_TIME_MULTIPLIER
+    void frame(float delta_time);
+    // runs GL work from the simulation side, on the render thread between two frames when there is one
+    void onRenderThread(const std::function<void()>& task);
 
     [[nodiscard]] char getSceneId() const { return scene_id; }
+    [[nodiscard]] Camera& getCamera() { return *camera; }
     [[nodiscard]] bool isFinished() const { return is_finished; }
     void finish() { is_finished = true; }
+    void setFixedTimeStep(float step) { fixed_time_step = step; }
+    void setFrameLimit(int frames) { frame_limit = frames; }
+    void setInput(InputRecorder* recorder) { input = recorder; }
+    void setRenderContext(const RenderContext* context) { render_context = context; }
 
     inline void continuousMovement(const float& delta_time);
     void update_aspect_ratio(const int& new_width, const int& new_height);
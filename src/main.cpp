@@ -2,11 +2,53 @@
 // E-Mail: sla0331@vsb.cz
 // Date of Creation: 18/9/2023
 
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 #include "core/application.h"
 
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--headless] [--size WxH] [--frames N] [--scene N] [--output frame.ppm]"
+                    " [--record input.bin | --replay input.bin] [--render-thread] [--sync-loading]\n", program);
+}
+
 int main(int argc, char **argv) {
-    Application app = Application(800,600, "ZPG - SLA0331");
+    int width = 800;
+    int height = 600;
+    LaunchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--size" && has_value) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--frames" && has_value) {
+            options.frames = atoi(argv[++i]);
+        } else if (arg == "--scene" && has_value) {
+            options.scene = atoi(argv[++i]);
+        } else if (arg == "--output" && has_value) {
+            options.output = argv[++i];
+        } else if (arg == "--record" && has_value) {
+            options.record = argv[++i];
+        } else if (arg == "--replay" && has_value) {
+            options.replay = argv[++i];
+        } else if (arg == "--render-thread") {
+            options.render_thread = true;
+        } else if (arg == "--sync-loading") {
+            options.async_loading = false;
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    Application app = Application(width, height, "ZPG - SLA0331", options);
     app.init();
     Application::info();
     app.run();
-}
\ No newline at end of file
+}
@@ -9,19 +9,28 @@
 #include "../../util/const.h"
 #include "../drawable.h"
 
+struct SnapshotDraw;
+
 class Animation {
 public:
     virtual ~Animation() = default;
 
     virtual void step(float delta_time) = 0;
 
+    // runs on the render thread, may only read state that stays fixed while the scene runs
     virtual void draw() = 0;
 
     virtual const SHADER_ALIAS_DATATYPE getShaderAlias() = 0;
     virtual void attachShader(IObserver* new_observer) = 0;
-    virtual void notifyShader() = 0;
+    // copy per-frame state into the frame snapshot, model parameters are copied by the snapshot itself
+    virtual void capture(SnapshotDraw& /*draw*/) {}
+    // uniforms beyond the model parameters, passed from the snapshot on the render thread
+    virtual void notifyShader(const SnapshotDraw& /*draw*/) {}
 
     virtual DrawableObject& getDrawableObject() = 0;
+
+    // whether the drawable object bounds cover everything the animation draws
+    virtual bool isCullable() { return true; }
 };
 
 enum AnimationArgs {
@@ -11,8 +11,8 @@ void CentricModelComponent::step(float delta_time) {
 
 void CentricComposite::addModel(std::unique_ptr<CentricModelComponent> model) {
     // Append the current model's matrix to the child's matrix
-    // setModelParent creates a weak_ptr to the parent's matrix
-    model->getDrawableObject().setModelParent(object->getModelComposite());
+    // the transform store composes the child's world matrix from the parent's one
+    model->getDrawableObject().setModelParent(*object);
 
     // set the rotation center to the child's position
     // it is based on initial position of model as a relative position to the parent
@@ -28,7 +28,6 @@ public:
 
     const SHADER_ALIAS_DATATYPE getShaderAlias() override { return object->getShaderAlias(); }
     void attachShader(IObserver* new_observer) override { object->attach(new_observer); }
-    void notifyShader() override { object->notifyModelParameters(); }
 
     DrawableObject& getDrawableObject() override { return *object; }
 };
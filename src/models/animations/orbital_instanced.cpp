@@ -0,0 +1,63 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <stdexcept>
+#include "orbital_instanced.h"
+#include "../../rendering/frame_snapshot.h"
+
+OrbitalInstanced::OrbitalInstanced(std::unique_ptr<DrawableObject> object) : object(std::move(object)) {}
+
+void OrbitalInstanced::addInstance(const OrbitalInstance& instance) {
+    if (instance.parent >= static_cast<int>(instances.size()))
+        throw std::runtime_error("OrbitalInstanced::addInstance: Parent has to be added before its children");
+
+    // the shader follows the chain only up to MAX_ORBIT_DEPTH parents
+    int depth = 0;
+    for (int parent = instance.parent; parent != -1; parent = instances[parent].parent) {
+        if (++depth > MAX_ORBIT_DEPTH)
+            throw std::runtime_error("OrbitalInstanced::addInstance: Orbit chain too deep");
+    }
+
+    instances.push_back(instance);
+    is_dirty = true;
+}
+
+void OrbitalInstanced::upload() {
+    std::vector<glm::vec4> texels;
+    texels.reserve(instances.size() * INSTANCE_TEXELS);
+    for (const auto& instance: instances) {
+        texels.emplace_back(instance.radius, instance.phase, instance.speed, instance.scale);
+        texels.emplace_back(instance.height, static_cast<float>(instance.parent), 0.f, 0.f);
+    }
+    buffer.upload(texels);
+    is_dirty = false;
+}
+
+void OrbitalInstanced::step(float delta_time) {
+    time += delta_time;
+}
+
+void OrbitalInstanced::attachShader(IObserver* new_observer) {
+    object->attach(new_observer);
+    attach(new_observer);
+}
+
+void OrbitalInstanced::capture(SnapshotDraw& draw) {
+    draw.time = time;
+}
+
+void OrbitalInstanced::notifyShader(const SnapshotDraw& draw) {
+    notify(EventPayload<TEXTURE_UNIT>{INSTANCE_TEXTURE_UNIT, EventType::U_INSTANCE_UNIT});
+    notify(EventPayload<float>{"orbit_time", draw.time, EventType::U_1F});
+}
+
+void OrbitalInstanced::draw() {
+    if (instances.empty())
+        return;
+
+    if (is_dirty)
+        upload();
+    buffer.bind(INSTANCE_TEXTURE_UNIT);
+    object->getModel()->drawInstanced(static_cast<GLsizei>(instances.size()));
+}
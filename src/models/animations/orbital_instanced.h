@@ -0,0 +1,67 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_ORBITAL_INSTANCED_H
+#define ZPG_ORBITAL_INSTANCED_H
+
+
+#include <vector>
+#include "animation.h"
+#include "../../rendering/instance_buffer.h"
+
+struct OrbitalInstance {
+    float radius;
+    float phase;        // initial angle in degrees
+    float speed;        // degrees per frame time unit, same as CentricModelComponent multiplier
+    float scale;
+    float height = 0.f;
+    int parent = -1;    // index of an earlier instance this one orbits, -1 orbits the center
+};
+
+//
+// Orbiting instances evaluated entirely in the vertex shader (see orbital.vert).
+// Parameters are uploaded once, every frame only the accumulated time is passed,
+// so the whole group costs a single instanced draw call and no per-instance CPU work.
+//
+// The prototype object provides the model, material and the orbit center -
+// parent it with setModelParent to follow a CentricComposite.
+//
+class OrbitalInstanced : public Animation, public ISubjectSingle {
+public:
+    // texels per instance, [0] radius, phase, speed, scale; [1] height, parent
+    static constexpr int INSTANCE_TEXELS = 2;
+    // keep in sync with MAX_ORBIT_DEPTH in orbital.vert
+    static constexpr int MAX_ORBIT_DEPTH = 4;
+private:
+    std::unique_ptr<DrawableObject> object;
+    std::vector<OrbitalInstance> instances;
+    float time = 0.f;
+
+    InstanceBuffer buffer;
+    bool is_dirty = false;
+private:
+    void upload();
+public:
+    explicit OrbitalInstanced(std::unique_ptr<DrawableObject> object);
+    ~OrbitalInstanced() override = default;
+
+    void addInstance(const OrbitalInstance& instance);
+    [[nodiscard]] size_t size() const { return instances.size(); }
+
+    void step(float delta_time) override;
+    void draw() override;
+
+    const SHADER_ALIAS_DATATYPE getShaderAlias() override { return object->getShaderAlias(); }
+    void attachShader(IObserver* new_observer) override;
+    void capture(SnapshotDraw& draw) override;
+    void notifyShader(const SnapshotDraw& draw) override;
+
+    DrawableObject& getDrawableObject() override { return *object; }
+
+    // instances are spread around the whole orbit, the prototype bounds don't cover them
+    bool isCullable() override { return false; }
+};
+
+
+#endif //ZPG_ORBITAL_INSTANCED_H
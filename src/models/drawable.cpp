@@ -3,6 +3,7 @@
 // Date of Creation:  2/10/2023
 
 #include "drawable.h"
+#include "../util/render_stats.h"
 
 #include <utility>
 #include <stdexcept>
@@ -12,10 +13,7 @@ DrawableObject::DrawableObject(const glm::vec3& position, const Model* model,
         : position(position),
           shader_name(std::move(shader_name)),
           model(model) {
-    this->model_matrix = std::make_shared<DynamicTransformComposite>();
-
-    EventPayload<glm::vec3> payload{this->position, EventType::S_TRANSLATION};
-    this->model_matrix->update(payload);
+    this->transform = TransformStore::get().create(this->position);
 }
 
 DrawableObject::DrawableObject(const glm::vec3& position,
@@ -25,10 +23,7 @@ DrawableObject::DrawableObject(const glm::vec3& position,
         : position(position),
           shader_name(std::move(shader_name)),
           model(model) {
-    this->model_matrix = std::make_shared<DynamicTransformComposite>();
-
-    EventPayload<glm::vec3> payload{this->position, EventType::S_TRANSLATION};
-    this->model_matrix->update(payload);
+    this->transform = TransformStore::get().create(this->position);
 
     this->material.ambient = ambient;
 }
@@ -41,73 +36,67 @@ DrawableObject::DrawableObject(const glm::vec3& position,
         : position(position),
           shader_name(std::move(shader_name)),
           model(model) {
-    this->model_matrix = std::make_shared<DynamicTransformComposite>(axis);
-
-    EventPayload<glm::vec3> payload{this->position, EventType::S_TRANSLATION};
-    this->model_matrix->update(payload);
+    this->transform = TransformStore::get().create(this->position, axis);
 
     this->material.ambient = ambient;
 }
 
+DrawableObject::~DrawableObject() {
+    TransformStore::get().release(this->transform);
+}
 
 void DrawableObject::draw() const {
-    if (this->interaction_id != 0)
+    if (this->interaction_id != 0) {
         glStencilFunc(GL_ALWAYS, this->interaction_id, 0xFF);
+        RenderStats::counters().stencil_changes++;
+    }
     if (this->model->isTextured())
         this->material.texture->bind();
     this->model->draw();
 }
 
-void DrawableObject::setModelParent(std::weak_ptr<DynamicTransformComposite> weak_parent) {
-    this->model_matrix->setParent(std::move(weak_parent));
+void DrawableObject::setModelParent(const DrawableObject& parent) {
+    TransformStore::get().setParent(this->transform, parent.transform);
 }
 
 const glm::mat4& DrawableObject::getModelMatrix() const {
-    return this->model_matrix->getMatrix();
+    return TransformStore::get().getWorld(this->transform);
 }
 
 const glm::mat3& DrawableObject::getNormalMatrix() const {
-    return this->model_matrix->getNormalMatrix();
+    return TransformStore::get().getNormal(this->transform);
 }
 
-void DrawableObject::setTranslate(const glm::vec3& location) {
-    EventPayload<glm::vec3> payload{location, EventType::S_TRANSLATION};
-    this->model_matrix->update(payload);
+void DrawableObject::setShaderRequirements(SHADER_REQUIREMENTS requirements) {
+    TransformStore::get().setNormalRequired(this->transform, requirements & REQUIRES_NORMAL_MATRIX);
 }
 
+void DrawableObject::setTranslate(const glm::vec3& location) {
+    TransformStore::get().setTranslation(this->transform, location);
+}
 
 void DrawableObject::translate(const glm::vec3& delta) {
-    EventPayload<glm::vec3> payload{delta, EventType::U_TRANSLATION};
-    this->model_matrix->update(payload);
+    TransformStore::get().translate(this->transform, delta);
 }
 
 void DrawableObject::setRotate(const glm::vec3& rotation) {
-    EventPayload<glm::vec3> payload{rotation, EventType::S_ROTATION};
-    this->model_matrix->update(payload);
+    TransformStore::get().setRotation(this->transform, rotation);
 }
 
 void DrawableObject::rotate(const glm::vec3& delta) {
-    EventPayload<glm::vec3> payload{delta, EventType::U_ROTATION};
-    this->model_matrix->update(payload);
+    TransformStore::get().rotate(this->transform, delta);
 }
 
 void DrawableObject::rotateAround(const float& delta, const glm::vec3& point) {
-    EventPayload<glm::vec3> point_payload{point, EventType::S_ROTATION_POINT_ORIGIN};
-    this->model_matrix->update(point_payload);
-
-    EventPayload<float> rotation_payload{delta, EventType::U_ROTATION_POINT_ANGLE};
-    this->model_matrix->update(rotation_payload);
-
+    TransformStore::get().orbit(this->transform, delta, point);
 }
 
 void DrawableObject::setScale(const glm::vec3& scale) {
-    EventPayload<glm::vec3> payload{scale, EventType::S_SCALE};
-    this->model_matrix->update(payload);
+    TransformStore::get().setScale(this->transform, scale);
 }
 
 void DrawableObject::scale(const glm::vec3& delta) {
-    EventPayload<glm::vec3> payload{delta, EventType::U_SCALE};
-    this->model_matrix->update(payload);
+    TransformStore::get().scale(this->transform, delta);
 }
 
 void DrawableObject::setAmbient(const glm::vec3& _ambient) {
@@ -138,11 +127,9 @@ void DrawableObject::setDiffuse(const glm::vec3& _diffuse) {
 }
 
 void DrawableObject::notifyModel() const {
-    notify(EventPayload<const glm::mat4*>{&this->model_matrix->getMatrix(),
-                                          EventType::U_MODEL_MATRIX});
+    notify(EventPayload<const glm::mat4*>{&getModelMatrix(), EventType::U_MODEL_MATRIX});
 
-    notify(EventPayload<const glm::mat3*>{&this->model_matrix->getNormalMatrix(),
-                                          EventType::U_NORMAL_MATRIX});
+    notify(EventPayload<const glm::mat3*>{&getNormalMatrix(), EventType::U_NORMAL_MATRIX});
 }
 
 void DrawableObject::notifyMaterial() const {
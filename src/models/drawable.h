@@ -6,11 +6,14 @@
 #define ZPG_DRAWABLE_H
 
 
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <variant>
 #include "glm/vec3.hpp"
 #include "model.h"
 #include "properties/material.h"
-#include "../transform/transform_composite.h"
+#include "../transform/transform_store.h"
 #include "../util/const.h"
 #include "../util/observer.h"
 
@@ -22,25 +25,36 @@ private:
     SHADER_ALIAS_DATATYPE shader_alias = 0;
 
     const Model* model;
-    std::shared_ptr<DynamicTransformComposite> model_matrix;
+    // handle into the TransformStore
+    TRANSFORM_ID transform;
 
     Material material;
 
     bool interact = false;
     char interaction_id = 0;
+
+    // leaf in the ObjectManager BVH, and the last culling pass that found the object visible
+    BVH_NODE_ID bvh_leaf = BVH_NULL_NODE;
+    uint32_t visible_frame = 0;
 public:
     DrawableObject(const glm::vec3& position, const Model* model, std::string shader_name);
     DrawableObject(const glm::vec3& position, const Model* model, std::string shader_name,
                    const glm::vec3& ambient);
     DrawableObject(const glm::vec3& position, const Model* model, std::string shader_name,
                    const glm::vec3& ambient, const glm::vec3& axis);
-    ~DrawableObject() = default;
+    ~DrawableObject();
+
+    // the transform handle is owned, objects cannot be copied
+    DrawableObject(const DrawableObject&) = delete;
+    DrawableObject& operator=(const DrawableObject&) = delete;
 
-    std::shared_ptr<DynamicTransformComposite> getModelComposite() { return model_matrix; }
-    void setModelParent(std::weak_ptr<DynamicTransformComposite> weak_parent);
+    [[nodiscard]] TRANSFORM_ID getTransform() const { return this->transform; }
+    void setModelParent(const DrawableObject& parent);
 
     [[nodiscard]] const glm::mat4& getModelMatrix() const;
     [[nodiscard]] const glm::mat3& getNormalMatrix() const;
+    // what the attached shader reads, the normal matrix is only kept up to date if it is used
+    void setShaderRequirements(SHADER_REQUIREMENTS requirements);
 
     [[nodiscard]] const std::string& getShaderName() const { return this->shader_name; }
     void assignShaderAlias(const SHADER_ALIAS_DATATYPE& alias) { this->shader_alias = alias; }
@@ -52,6 +66,12 @@ public:
     void setInteractionID(const char& id);
     [[nodiscard]] char getInteractionID() const;
 
+    void setBVHLeaf(BVH_NODE_ID leaf) { this->bvh_leaf = leaf; }
+    [[nodiscard]] BVH_NODE_ID getBVHLeaf() const { return this->bvh_leaf; }
+
+    void markVisible(uint32_t frame) { this->visible_frame = frame; }
+    [[nodiscard]] bool isVisible(uint32_t frame) const { return this->visible_frame == frame; }
+
     void setTranslate(const glm::vec3& location);
     void translate(const glm::vec3& delta);
 
@@ -71,6 +91,7 @@ public:
     void assignTexture(const Texture* texture);
 
     [[nodiscard]] const glm::vec3& getPosition() const { return this->position; }
+    [[nodiscard]] const Model* getModel() const { return this->model; }
     [[nodiscard]] const Material& getMaterial() const { return this->material; }
 
     void notifyModel() const;
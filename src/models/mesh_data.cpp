@@ -0,0 +1,74 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <cstring>
+#include "mesh_data.h"
+#include "mesh_optimizer.h"
+#include "vertex_format.h"
+#include "../util/const.h"
+
+namespace {
+    template<typename T>
+    std::vector<uint8_t> toBytes(const T* values, size_t count) {
+        std::vector<uint8_t> bytes(count * sizeof(T));
+        if (count > 0)
+            std::memcpy(bytes.data(), values, bytes.size());
+        return bytes;
+    }
+}
+
+EncodedMesh EncodedMesh::encode(ModelOptions options, const float* vertices, int vertex_count,
+                                const uint32_t* indices, int index_count) {
+    const int stride = Model::getStrideFromOptions(options);
+
+    EncodedMesh mesh;
+    MeshData& data = mesh.data;
+    data.bounds = Bounds::fromVertices(vertices, vertex_count, stride);
+    data.options = VertexFormat::resolve(options, vertices, vertex_count);
+    data.vertex_count = static_cast<GLsizei>(vertex_count);
+
+    if (VertexFormat::isCompressed(data.options))
+        mesh.vertices = VertexFormat::encode(data.options, vertices, vertex_count, data.bounds);
+    else
+        mesh.vertices = toBytes(vertices, static_cast<size_t>(vertex_count) * stride);
+
+    if (data.options & ModelOptions::POSITION_STREAM)
+        mesh.positions = VertexFormat::encodePositions(data.options, vertices, vertex_count, data.bounds);
+
+    if (index_count > 0) {
+        data.index_count = static_cast<GLsizei>(index_count);
+        if (vertex_count <= UINT16_MAX + 1) {
+            std::vector<uint16_t> short_indices(indices, indices + index_count);
+            data.index_type = GL_UNSIGNED_SHORT;
+            mesh.indices = toBytes(short_indices.data(), short_indices.size());
+        } else {
+            data.index_type = GL_UNSIGNED_INT;
+            mesh.indices = toBytes(indices, static_cast<size_t>(index_count));
+        }
+    }
+    return mesh;
+}
+
+EncodedMesh EncodedMesh::weld(ModelOptions options, const float* vertices, int vertex_count) {
+    if (ENABLE_VERTEX_WELDING) {
+        IndexedMesh mesh = MeshOptimizer::weld(vertices, vertex_count, Model::getStrideFromOptions(options));
+        // an element buffer only pays off when corners were actually shared
+        if (mesh.getVertexCount() < static_cast<size_t>(vertex_count)) {
+            return encode(options, mesh.vertices.data(), static_cast<int>(mesh.getVertexCount()),
+                          mesh.indices.data(), static_cast<int>(mesh.indices.size()));
+        }
+    }
+    return encode(options, vertices, vertex_count, nullptr, 0);
+}
+
+MeshData EncodedMesh::getData() const {
+    MeshData view = data;
+    view.vertices = vertices.data();
+    view.vertices_size = static_cast<GLsizeiptr>(vertices.size());
+    view.indices = indices.empty() ? nullptr : indices.data();
+    view.indices_size = static_cast<GLsizeiptr>(indices.size());
+    view.positions = positions.empty() ? nullptr : positions.data();
+    view.positions_size = static_cast<GLsizeiptr>(positions.size());
+    return view;
+}
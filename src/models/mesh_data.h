@@ -0,0 +1,61 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_MESH_DATA_H
+#define ZPG_MESH_DATA_H
+
+//Include GLEW
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <vector>
+#include "model.h"
+#include "properties/bounds.h"
+
+// GPU ready geometry of a model, exactly what ends up in its buffers
+// the pointers are not owned, they point into an EncodedMesh or a mapped MeshFile
+struct MeshData {
+    // layout and compression of the vertices, see VertexFormat
+    ModelOptions options = ModelOptions::UNKNOWN;
+    Bounds bounds;
+
+    GLsizei vertex_count = 0;
+    const void* vertices = nullptr;
+    GLsizeiptr vertices_size = 0; // bytes
+
+    // GL_NONE and no indices for unindexed meshes
+    GLenum index_type = GL_NONE;
+    GLsizei index_count = 0;
+    const void* indices = nullptr;
+    GLsizeiptr indices_size = 0;
+
+    // POSITION_STREAM only
+    const void* positions = nullptr;
+    GLsizeiptr positions_size = 0;
+};
+
+//
+// Float vertices turned into MeshData on the CPU, shared by Model and the offline converter (tools/zpg_meshc.cpp),
+// needs no GL context.
+//
+class EncodedMesh {
+private:
+    MeshData data;
+    std::vector<uint8_t> vertices;
+    std::vector<uint8_t> indices;
+    std::vector<uint8_t> positions;
+public:
+    // vertices are interleaved floats as options say, indices may be null
+    static EncodedMesh encode(ModelOptions options, const float* vertices, int vertex_count,
+                              const uint32_t* indices, int index_count);
+
+    // unindexed vertices, welded into an indexed mesh when ENABLE_VERTEX_WELDING is set and it shares any
+    static EncodedMesh weld(ModelOptions options, const float* vertices, int vertex_count);
+
+    // valid while this mesh lives
+    [[nodiscard]] MeshData getData() const;
+};
+
+
+#endif //ZPG_MESH_DATA_H
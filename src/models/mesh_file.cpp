@@ -0,0 +1,196 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "mesh_file.h"
+#include "vertex_format.h"
+#include "../util/const.h"
+
+static_assert(std::is_trivially_copyable_v<MeshFileHeader>, "MeshFileHeader is written as is");
+static_assert(sizeof(MeshFileHeader) % MeshFile::MESH_FILE_ALIGNMENT == 0, "blobs have to start aligned");
+
+namespace {
+    uint64_t align(uint64_t offset) {
+        return (offset + MeshFile::MESH_FILE_ALIGNMENT - 1) & ~static_cast<uint64_t>(MeshFile::MESH_FILE_ALIGNMENT - 1);
+    }
+
+    MeshFileBlob place(uint64_t& offset, GLsizeiptr size) {
+        if (size == 0)
+            return MeshFileBlob{0, 0};
+        MeshFileBlob blob{align(offset), static_cast<uint64_t>(size)};
+        offset = blob.offset + blob.size;
+        return blob;
+    }
+
+    void writeBlob(FILE* file, const MeshFileBlob& blob, const void* data) {
+        if (blob.size == 0)
+            return;
+        fseek(file, static_cast<long>(blob.offset), SEEK_SET);
+        fwrite(data, 1, blob.size, file);
+    }
+}
+
+MeshFile::MeshFile(const std::string& path) : path(path) {
+#ifdef _WIN32
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        throw std::runtime_error("MeshFile::MeshFile: Cannot open " + path);
+    fseek(file, 0, SEEK_END);
+    fallback.resize(static_cast<size_t>(ftell(file)));
+    fseek(file, 0, SEEK_SET);
+    size_t read = fread(fallback.data(), 1, fallback.size(), file);
+    fclose(file);
+    if (read != fallback.size())
+        throw std::runtime_error("MeshFile::MeshFile: Cannot read " + path);
+    this->mapping = fallback.data();
+    this->size = fallback.size();
+#else
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        throw std::runtime_error("MeshFile::MeshFile: Cannot open " + path);
+    struct stat info{};
+    if (fstat(descriptor, &info) != 0 || info.st_size == 0) {
+        close(descriptor);
+        throw std::runtime_error("MeshFile::MeshFile: Cannot read " + path);
+    }
+    this->size = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // the mapping keeps its own reference to the file
+    close(descriptor);
+    if (mapped == MAP_FAILED)
+        throw std::runtime_error("MeshFile::MeshFile: Cannot map " + path);
+    this->mapping = static_cast<const uint8_t*>(mapped);
+#endif
+
+    this->header = reinterpret_cast<const MeshFileHeader*>(this->mapping);
+    validate();
+}
+
+MeshFile::~MeshFile() {
+#ifndef _WIN32
+    if (this->mapping != nullptr)
+        munmap(const_cast<uint8_t*>(this->mapping), this->size);
+#endif
+}
+
+void MeshFile::validate() const {
+    auto fail = [this](const char* reason) {
+#ifndef _WIN32
+        munmap(const_cast<uint8_t*>(this->mapping), this->size);
+#endif
+        throw std::runtime_error("MeshFile::validate: " + this->path + " " + reason);
+    };
+
+    if (this->size < sizeof(MeshFileHeader) || std::memcmp(header->magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC)) != 0)
+        fail("is not a mesh file");
+    if (header->version != MESH_FILE_VERSION)
+        fail("was written by another version of zpg_meshc, convert it again");
+    auto options = static_cast<ModelOptions>(header->options);
+    if (header->vertex_size != static_cast<uint32_t>(VertexFormat::getVertexSize(options)))
+        fail("has a vertex layout this build does not know");
+
+    for (const MeshFileBlob* blob: {&header->vertices, &header->indices, &header->positions}) {
+        if (blob->offset > this->size || blob->size > this->size - blob->offset)
+            fail("is truncated");
+    }
+    if (header->vertices.size != static_cast<uint64_t>(header->vertex_count) * header->vertex_size)
+        fail("has a vertex blob of the wrong size");
+    const uint64_t index_size = header->index_type == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+    if (header->indices.size != static_cast<uint64_t>(header->index_count) * index_size)
+        fail("has an index blob of the wrong size");
+}
+
+MeshData MeshFile::getData() const {
+    MeshData data;
+    data.options = static_cast<ModelOptions>(header->options);
+    data.bounds.min = glm::vec3(header->bounds_min[0], header->bounds_min[1], header->bounds_min[2]);
+    data.bounds.max = glm::vec3(header->bounds_max[0], header->bounds_max[1], header->bounds_max[2]);
+    data.bounds.center = glm::vec3(header->bounds_center[0], header->bounds_center[1], header->bounds_center[2]);
+    data.bounds.radius = header->bounds_radius;
+
+    data.vertex_count = static_cast<GLsizei>(header->vertex_count);
+    data.vertices = this->mapping + header->vertices.offset;
+    data.vertices_size = static_cast<GLsizeiptr>(header->vertices.size);
+
+    data.index_type = static_cast<GLenum>(header->index_type);
+    data.index_count = static_cast<GLsizei>(header->index_count);
+    if (header->indices.size > 0) {
+        data.indices = this->mapping + header->indices.offset;
+        data.indices_size = static_cast<GLsizeiptr>(header->indices.size);
+    }
+    if (header->positions.size > 0) {
+        data.positions = this->mapping + header->positions.offset;
+        data.positions_size = static_cast<GLsizeiptr>(header->positions.size);
+    }
+    return data;
+}
+
+Material MeshFile::getMaterial() const {
+    Material material;
+    material.ambient = glm::vec3(header->ambient[0], header->ambient[1], header->ambient[2]);
+    material.diffuse = glm::vec3(header->diffuse[0], header->diffuse[1], header->diffuse[2]);
+    material.specular = glm::vec3(header->specular[0], header->specular[1], header->specular[2]);
+    material.shininess = header->shininess;
+    return material;
+}
+
+void MeshFile::write(const std::string& path, const MeshData& data, const Material* material) {
+    MeshFileHeader header{};
+    std::memcpy(header.magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC));
+    header.version = MESH_FILE_VERSION;
+    header.options = data.options;
+    header.vertex_size = static_cast<uint32_t>(VertexFormat::getVertexSize(data.options));
+    header.vertex_count = static_cast<uint32_t>(data.vertex_count);
+    header.index_count = static_cast<uint32_t>(data.index_count);
+    header.index_type = data.index_type;
+
+    for (int i = 0; i < 3; i++) {
+        header.bounds_min[i] = data.bounds.min[i];
+        header.bounds_max[i] = data.bounds.max[i];
+        header.bounds_center[i] = data.bounds.center[i];
+    }
+    header.bounds_radius = data.bounds.radius;
+
+    if (material != nullptr) {
+        header.has_material = 1;
+        for (int i = 0; i < 3; i++) {
+            header.ambient[i] = material->ambient[i];
+            header.diffuse[i] = material->diffuse[i];
+            header.specular[i] = material->specular[i];
+        }
+        header.shininess = material->shininess;
+    }
+
+    uint64_t offset = sizeof(MeshFileHeader);
+    header.vertices = place(offset, data.vertices_size);
+    header.indices = place(offset, data.indices_size);
+    header.positions = place(offset, data.positions_size);
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        throw std::runtime_error("MeshFile::write: Cannot open " + path + " for writing");
+    fwrite(&header, sizeof(header), 1, file);
+    writeBlob(file, header.vertices, data.vertices);
+    writeBlob(file, header.indices, data.indices);
+    writeBlob(file, header.positions, data.positions);
+    fclose(file);
+}
+
+bool MeshFile::exists(const std::string& path) {
+    struct stat info{};
+    return stat(path.c_str(), &info) == 0;
+}
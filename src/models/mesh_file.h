@@ -0,0 +1,86 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_MESH_FILE_H
+#define ZPG_MESH_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "mesh_data.h"
+#include "properties/material.h"
+
+// one blob of the file, offsets are from the start of the file
+struct MeshFileBlob {
+    uint64_t offset;
+    uint64_t size;
+};
+
+// little endian, blobs follow the header aligned to MESH_FILE_ALIGNMENT
+struct MeshFileHeader {
+    char magic[4];
+    uint32_t version;
+    // ModelOptions the blobs were encoded with, the vertex layout descriptor
+    uint32_t options;
+    // bytes, has to agree with VertexFormat::getVertexSize(options)
+    uint32_t vertex_size;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    // GL_NONE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    uint32_t index_type;
+    // assets converted from .obj carry their material, the static meshes do not
+    uint32_t has_material;
+
+    float bounds_min[3];
+    float bounds_max[3];
+    float bounds_center[3];
+    float bounds_radius;
+
+    float ambient[3];
+    float diffuse[3];
+    float specular[3];
+    float shininess;
+
+    MeshFileBlob vertices;
+    MeshFileBlob indices;
+    MeshFileBlob positions;
+};
+
+//
+// Read-only mapping of a converted mesh (.zmesh). The blobs are already in their GPU format,
+// MeshData points straight into the mapping, so loading is a glBufferData per blob and nothing is parsed.
+// The mapping only has to live until the Model is created.
+//
+class MeshFile {
+private:
+    std::string path;
+    const uint8_t* mapping = nullptr;
+    size_t size = 0;
+    // platforms without mmap read the file into it instead
+    std::vector<uint8_t> fallback;
+
+    const MeshFileHeader* header = nullptr;
+private:
+    void validate() const;
+public:
+    static constexpr size_t MESH_FILE_ALIGNMENT = 16;
+
+    explicit MeshFile(const std::string& path);
+    ~MeshFile();
+
+    MeshFile(const MeshFile&) = delete;
+    MeshFile& operator=(const MeshFile&) = delete;
+
+    [[nodiscard]] MeshData getData() const;
+    [[nodiscard]] bool hasMaterial() const { return header->has_material != 0; }
+    // only the colors, textures are assigned by the scene
+    [[nodiscard]] Material getMaterial() const;
+
+    // material may be null
+    static void write(const std::string& path, const MeshData& data, const Material* material);
+    static bool exists(const std::string& path);
+};
+
+
+#endif //ZPG_MESH_FILE_H
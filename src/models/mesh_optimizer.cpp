@@ -0,0 +1,331 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "glm/glm.hpp"
+#include "mesh_optimizer.h"
+#include "../util/const.h"
+
+namespace {
+    constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    // FNV-1a over the float bit patterns, -0.0 and 0.0 stay different vertices
+    uint32_t hashVertex(const float* vertex, int stride) {
+        uint32_t hash = 2166136261u;
+        for (int i = 0; i < stride; i++) {
+            uint32_t bits;
+            std::memcpy(&bits, &vertex[i], sizeof(bits));
+            hash = (hash ^ bits) * 16777619u;
+        }
+        // the low bits pick the slot, fold the high ones in
+        return hash ^ (hash >> 15);
+    }
+
+    // Forsyth's scoring constants, tuned for an LRU cache of VERTEX_CACHE_SIZE entries
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    float vertexScore(int cache_position, uint32_t remaining_triangles) {
+        // nothing left to draw with it, keep it out of every choice
+        if (remaining_triangles == 0)
+            return -1.0f;
+
+        float score = 0.0f;
+        if (cache_position >= 0) {
+            // the vertices of the last triangle get a fixed score, so the next one does not just reuse its edge
+            if (cache_position < 3) {
+                score = LAST_TRIANGLE_SCORE;
+            } else {
+                const float scale = 1.0f / static_cast<float>(VERTEX_CACHE_SIZE - 3);
+                score = std::pow(1.0f - static_cast<float>(cache_position - 3) * scale, CACHE_DECAY_POWER);
+            }
+        }
+        // vertices with few triangles left are finished off first, so they do not need another fetch later
+        score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining_triangles), -VALENCE_BOOST_POWER);
+        return score;
+    }
+
+    // triangles using each vertex, the live ones of vertex v are
+    // triangles[offsets[v], offsets[v] + remaining[v]) and the emitted ones are swapped past them
+    struct TriangleAdjacency {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> remaining;
+        std::vector<uint32_t> triangles;
+
+        TriangleAdjacency(const std::vector<uint32_t>& indices, size_t vertex_count)
+                : offsets(vertex_count + 1, 0), remaining(vertex_count, 0), triangles(indices.size()) {
+            for (uint32_t index : indices)
+                remaining[index]++;
+            for (size_t v = 0; v < vertex_count; v++)
+                offsets[v + 1] = offsets[v] + remaining[v];
+
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indices.size(); i++)
+                triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        void remove(uint32_t vertex, uint32_t triangle) {
+            uint32_t* first = &triangles[offsets[vertex]];
+            uint32_t* last = first + remaining[vertex];
+            uint32_t* found = std::find(first, last, triangle);
+            if (found == last)
+                return;
+            std::swap(*found, *(last - 1));
+            remaining[vertex]--;
+        }
+    };
+}
+
+IndexedMesh MeshOptimizer::weld(const float* vertices, size_t vertex_count, int stride) {
+    IndexedMesh mesh;
+    mesh.stride = stride;
+    mesh.indices.reserve(vertex_count);
+
+    // open addressing table of output vertices, at most half full
+    size_t table_size = 16;
+    while (table_size < vertex_count * 2)
+        table_size <<= 1;
+    std::vector<uint32_t> table(table_size, EMPTY_SLOT);
+    const size_t vertex_size = stride * sizeof(float);
+
+    for (size_t i = 0; i < vertex_count; i++) {
+        const float* vertex = vertices + i * stride;
+        size_t slot = hashVertex(vertex, stride) & (table_size - 1);
+        while (true) {
+            uint32_t candidate = table[slot];
+            if (candidate == EMPTY_SLOT) {
+                candidate = static_cast<uint32_t>(mesh.getVertexCount());
+                table[slot] = candidate;
+                mesh.vertices.insert(mesh.vertices.end(), vertex, vertex + stride);
+                mesh.indices.push_back(candidate);
+                break;
+            }
+            if (std::memcmp(&mesh.vertices[candidate * stride], vertex, vertex_size) == 0) {
+                mesh.indices.push_back(candidate);
+                break;
+            }
+            slot = (slot + 1) & (table_size - 1);
+        }
+    }
+    return mesh;
+}
+
+void MeshOptimizer::optimizeVertexCache(IndexedMesh& mesh) {
+    const size_t vertex_count = mesh.getVertexCount();
+    const size_t triangle_count = mesh.indices.size() / 3;
+    if (triangle_count == 0)
+        return;
+
+    TriangleAdjacency adjacency(mesh.indices, vertex_count);
+
+    std::vector<int> cache_positions(vertex_count, -1);
+    std::vector<float> vertex_scores(vertex_count);
+    for (size_t v = 0; v < vertex_count; v++)
+        vertex_scores[v] = vertexScore(-1, adjacency.remaining[v]);
+
+    std::vector<float> triangle_scores(triangle_count);
+    for (size_t t = 0; t < triangle_count; t++) {
+        const uint32_t* triangle = &mesh.indices[t * 3];
+        triangle_scores[t] = vertex_scores[triangle[0]] + vertex_scores[triangle[1]] + vertex_scores[triangle[2]];
+    }
+
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<uint32_t> output;
+    output.reserve(mesh.indices.size());
+
+    // LRU order, the extra room holds the vertices pushed out by the last triangle
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> new_cache;
+    cache.reserve(VERTEX_CACHE_SIZE + 3);
+    new_cache.reserve(VERTEX_CACHE_SIZE + 3);
+
+    auto best = static_cast<int64_t>(std::max_element(triangle_scores.begin(), triangle_scores.end())
+                                     - triangle_scores.begin());
+    // next triangle to try when nothing in the cache has any triangles left
+    size_t cursor = 0;
+    while (best >= 0) {
+        const auto triangle_index = static_cast<uint32_t>(best);
+        const uint32_t* triangle = &mesh.indices[triangle_index * 3];
+        emitted[triangle_index] = true;
+        output.insert(output.end(), triangle, triangle + 3);
+
+        // the triangle moves to the front, the rest of the cache keeps its order
+        new_cache.clear();
+        for (int k = 0; k < 3; k++) {
+            adjacency.remove(triangle[k], triangle_index);
+            if (std::find(new_cache.begin(), new_cache.end(), triangle[k]) == new_cache.end())
+                new_cache.push_back(triangle[k]);
+        }
+        for (uint32_t vertex : cache) {
+            if (std::find(new_cache.begin(), new_cache.end(), vertex) == new_cache.end())
+                new_cache.push_back(vertex);
+        }
+
+        // rescore every vertex that moved, including the evicted ones, and push the change to their triangles
+        for (size_t i = 0; i < new_cache.size(); i++) {
+            uint32_t vertex = new_cache[i];
+            cache_positions[vertex] = i < VERTEX_CACHE_SIZE ? static_cast<int>(i) : -1;
+            float score = vertexScore(cache_positions[vertex], adjacency.remaining[vertex]);
+            float delta = score - vertex_scores[vertex];
+            vertex_scores[vertex] = score;
+
+            const uint32_t first = adjacency.offsets[vertex];
+            for (uint32_t j = first; j < first + adjacency.remaining[vertex]; j++)
+                triangle_scores[adjacency.triangles[j]] += delta;
+        }
+        cache.assign(new_cache.begin(), new_cache.begin() + std::min(new_cache.size(), VERTEX_CACHE_SIZE));
+
+        // only triangles touching the cache can score well, the cache bounds the search
+        best = -1;
+        float best_score = -1.0f;
+        for (uint32_t vertex : cache) {
+            const uint32_t first = adjacency.offsets[vertex];
+            for (uint32_t j = first; j < first + adjacency.remaining[vertex]; j++) {
+                uint32_t candidate = adjacency.triangles[j];
+                if (triangle_scores[candidate] > best_score) {
+                    best_score = triangle_scores[candidate];
+                    best = candidate;
+                }
+            }
+        }
+        if (best < 0) {
+            while (cursor < triangle_count && emitted[cursor])
+                cursor++;
+            if (cursor < triangle_count)
+                best = static_cast<int64_t>(cursor);
+        }
+    }
+    mesh.indices.swap(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(IndexedMesh& mesh) {
+    const size_t vertex_count = mesh.getVertexCount();
+    const size_t triangle_count = mesh.indices.size() / 3;
+    if (triangle_count == 0)
+        return;
+
+    // a cluster ends where a triangle misses the cache with all three vertices,
+    // reordering at those points costs (almost) no vertex cache reuse
+    std::vector<size_t> cluster_starts;
+    std::vector<uint32_t> timestamps(vertex_count, 0);
+    uint32_t time = VERTEX_CACHE_SIZE + 1;
+    for (size_t t = 0; t < triangle_count; t++) {
+        int misses = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t vertex = mesh.indices[t * 3 + k];
+            if (time - timestamps[vertex] > VERTEX_CACHE_SIZE) {
+                timestamps[vertex] = time++;
+                misses++;
+            }
+        }
+        if (misses == 3 || t == 0)
+            cluster_starts.push_back(t);
+    }
+    cluster_starts.push_back(triangle_count);
+
+    auto position = [&](uint32_t vertex) {
+        const float* p = &mesh.vertices[vertex * mesh.stride];
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+
+    glm::vec3 mesh_centroid(0.0f);
+    for (size_t v = 0; v < vertex_count; v++)
+        mesh_centroid += position(static_cast<uint32_t>(v));
+    mesh_centroid /= static_cast<float>(vertex_count);
+
+    // how far out the cluster faces, area weighted centroid against the mesh centre along the cluster normal
+    const size_t cluster_count = cluster_starts.size() - 1;
+    std::vector<float> sort_keys(cluster_count);
+    for (size_t cluster = 0; cluster < cluster_count; cluster++) {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = cluster_starts[cluster]; t < cluster_starts[cluster + 1]; t++) {
+            glm::vec3 a = position(mesh.indices[t * 3]);
+            glm::vec3 b = position(mesh.indices[t * 3 + 1]);
+            glm::vec3 c = position(mesh.indices[t * 3 + 2]);
+            glm::vec3 cross = glm::cross(b - a, c - a);
+            float triangle_area = glm::length(cross);
+            centroid += (a + b + c) * (triangle_area / 3.0f);
+            normal += cross;
+            area += triangle_area;
+        }
+        float normal_length = glm::length(normal);
+        sort_keys[cluster] = area > 0.0f && normal_length > 0.0f
+                       ? glm::dot(centroid / area - mesh_centroid, normal / normal_length)
+                       : 0.0f;
+    }
+
+    std::vector<size_t> order(cluster_count);
+    for (size_t c = 0; c < cluster_count; c++)
+        order[c] = c;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return sort_keys[a] > sort_keys[b]; });
+
+    std::vector<uint32_t> output;
+    output.reserve(mesh.indices.size());
+    for (size_t c : order) {
+        output.insert(output.end(), mesh.indices.begin() + static_cast<ptrdiff_t>(cluster_starts[c] * 3),
+                      mesh.indices.begin() + static_cast<ptrdiff_t>(cluster_starts[c + 1] * 3));
+    }
+    mesh.indices.swap(output);
+}
+
+void MeshOptimizer::optimizeVertexFetch(IndexedMesh& mesh) {
+    std::vector<uint32_t> remap(mesh.getVertexCount(), EMPTY_SLOT);
+    std::vector<float> vertices;
+    vertices.reserve(mesh.vertices.size());
+
+    uint32_t next = 0;
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == EMPTY_SLOT) {
+            remap[index] = next++;
+            const float* vertex = &mesh.vertices[index * mesh.stride];
+            vertices.insert(vertices.end(), vertex, vertex + mesh.stride);
+        }
+        index = remap[index];
+    }
+    mesh.vertices.swap(vertices);
+}
+
+void MeshOptimizer::optimize(IndexedMesh& mesh, const char* name) {
+    VertexCacheStats before = analyzeVertexCache(mesh);
+
+    optimizeVertexCache(mesh);
+    if (ENABLE_OVERDRAW_OPTIMIZATION)
+        optimizeOverdraw(mesh);
+    optimizeVertexFetch(mesh);
+
+    VertexCacheStats after = analyzeVertexCache(mesh);
+    printf("Optimized mesh %s: %zu vertices, %zu triangles, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+           name, mesh.getVertexCount(), mesh.indices.size() / 3, before.acmr, after.acmr, before.atvr, after.atvr);
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(const IndexedMesh& mesh) {
+    VertexCacheStats stats;
+    const size_t vertex_count = mesh.getVertexCount();
+    const size_t triangle_count = mesh.indices.size() / 3;
+    if (triangle_count == 0 || vertex_count == 0)
+        return stats;
+
+    // a FIFO cache as timestamps, a vertex is cached while fewer than VERTEX_CACHE_SIZE misses came after it
+    std::vector<uint32_t> timestamps(vertex_count, 0);
+    uint32_t time = VERTEX_CACHE_SIZE + 1;
+    size_t misses = 0;
+    for (uint32_t index : mesh.indices) {
+        if (time - timestamps[index] > VERTEX_CACHE_SIZE) {
+            timestamps[index] = time++;
+            misses++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(triangle_count);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(vertex_count);
+    return stats;
+}
@@ -0,0 +1,53 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_MESH_OPTIMIZER_H
+#define ZPG_MESH_OPTIMIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// interleaved vertices (stride floats each) and the triangle list or strip indexing them
+struct IndexedMesh {
+    int stride = 0;
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+
+    [[nodiscard]] size_t getVertexCount() const { return stride > 0 ? vertices.size() / stride : 0; }
+};
+
+// post-transform cache efficiency of a triangle list, as seen by a FIFO cache of VERTEX_CACHE_SIZE entries
+struct VertexCacheStats {
+    // vertex shader invocations per triangle, 3 without any reuse, ~0.5 at best
+    float acmr = 0.0f;
+    // vertex shader invocations per vertex, 1 at best
+    float atvr = 0.0f;
+};
+
+//
+// Load time passes over model geometry, run once before the data is uploaded.
+//
+class MeshOptimizer {
+public:
+    // merge bitwise identical vertices of an unindexed vertex soup, keeps the primitive order
+    static IndexedMesh weld(const float* vertices, size_t vertex_count, int stride);
+
+    // the passes below work on triangle lists only
+
+    // reorder triangles for vertex cache reuse, Forsyth's linear-speed greedy scoring
+    static void optimizeVertexCache(IndexedMesh& mesh);
+    // split the cache optimized order where the cache restarts anyway and draw outward facing clusters first,
+    // so that front triangles of convex-ish parts tend to occlude the rest
+    static void optimizeOverdraw(IndexedMesh& mesh);
+    // renumber vertices in the order the indices first use them, unreferenced ones are dropped
+    static void optimizeVertexFetch(IndexedMesh& mesh);
+    // all of the above in order, prints the cache statistics before and after
+    static void optimize(IndexedMesh& mesh, const char* name);
+
+    static VertexCacheStats analyzeVertexCache(const IndexedMesh& mesh);
+};
+
+
+#endif //ZPG_MESH_OPTIMIZER_H
@@ -15,85 +15,131 @@
 #include "glm/gtc/type_ptr.hpp" // glm::value_ptr
 
 #include "model.h"
+#include "mesh_data.h"
+#include "vertex_format.h"
+#include "../util/render_stats.h"
 #include <algorithm>
 #include <stdexcept>
 
-Model::Model(const float* vertices, int total_count) : vao(0), vbo(0) {
-
-    this->vertices_count = static_cast<GLsizei>(total_count / 3 / 2);
-
-    glGenBuffers(1, &this->vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizei>(this->vertices_count * 6 * sizeof(float)), &vertices[0],
-                 GL_STATIC_DRAW);
+Model::Model(const float* vertices, int total_count) :
+        Model(vertices, total_count, static_cast<ModelOptions>(ModelOptions::VERTICES | ModelOptions::NORMALS)) {
+}
 
-    glGenVertexArrays(1, &this->vao); //generate the VAO
-    glBindVertexArray(this->vao); //bind the VAO
-    glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
+Model::Model(const float* vertices, int total_count, ModelOptions options) {
+    upload(EncodedMesh::weld(options, vertices, total_count / getStrideFromOptions(options)).getData());
+}
 
-    // using the following lines we will tell the GPU how to read the data
-    // vertex positions ->
-    glEnableVertexAttribArray(0); //enable vertex attributes
-    glVertexAttribPointer(0, 3,
-                          GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*) 0);
-    // vertex normals ->
-    glEnableVertexAttribArray(1); //enable vertex attributes
-    glVertexAttribPointer(1, 3,
-                          GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*) (3 * sizeof(float)));
+Model::Model(const float* vertices, int vertex_count, const uint32_t* indices, int index_count,
+             ModelOptions options) {
+    upload(EncodedMesh::encode(options, vertices, vertex_count, indices, index_count).getData());
+}
 
+Model::Model(const MeshData& mesh) {
+    upload(mesh);
 }
 
-Model::Model(const float* vertices, int total_count, ModelOptions options) : model_options(options) {
-    auto stride = getStrideFromOptions(options);
-    this->vertices_count = static_cast<GLsizei>(total_count / stride);
+void Model::upload(const MeshData& mesh) {
+    this->model_options = mesh.options;
+    this->stride = getStrideFromOptions(mesh.options);
+    this->vertices_count = mesh.vertex_count;
+    this->bounds = mesh.bounds;
+    this->vertex_size = VertexFormat::getVertexSize(this->model_options);
+    this->dequantization = VertexFormat::getDequantization(this->model_options, this->bounds);
 
     glGenBuffers(1, &this->vbo);
     glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizei>(this->vertices_count * stride * sizeof(float)), &vertices[0],
-                 GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, mesh.vertices_size, mesh.vertices, GL_STATIC_DRAW);
+
+    if (mesh.positions != nullptr) {
+        glGenBuffers(1, &this->position_vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, this->position_vbo);
+        glBufferData(GL_ARRAY_BUFFER, mesh.positions_size, mesh.positions, GL_STATIC_DRAW);
+
+        glGenVertexArrays(1, &this->position_vao);
+        glBindVertexArray(this->position_vao);
+        VertexFormat::setPositionAttribute(this->model_options, VertexFormat::getPositionSize(this->model_options));
+    }
 
     glGenVertexArrays(1, &this->vao); //generate the VAO
     glBindVertexArray(this->vao); //bind the VAO
     glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
 
-    glEnableVertexAttribArray(0); //enable vertex attributes
-    // vertex positions ->
-    glVertexAttribPointer(0, 3,
-                          GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride * sizeof(float)), (void*) 0);
-
     // using the following lines we will tell the GPU how to read the data
-    // normals
-    if (options & ModelOptions::NORMALS) {
-        // vertex normals ->
-        glEnableVertexAttribArray(1); //enable vertex attributes
-        glVertexAttribPointer(1, 3,
-                              GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride * sizeof(float)), (void*) (3 * sizeof(float)));
-    }
-    // texture coords
-    if (options & ModelOptions::TEXTURED_UV) {
-        // vertex texture coords ->
-        glEnableVertexAttribArray(2); //enable vertex attributes
-        glVertexAttribPointer(2, 2,
-                              GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride * sizeof(float)), (void*) (6 * sizeof(float)));
+    // positions, normals and texture coords as the options say
+    VertexFormat::setAttributes(this->model_options);
+
+    if (mesh.index_count == 0)
+        return;
+
+    // the element buffer binding is part of the VAO state, the VAO is still bound
+    this->indices_count = mesh.index_count;
+    this->index_type = mesh.index_type;
+    glGenBuffers(1, &this->ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices_size, mesh.indices, GL_STATIC_DRAW);
+
+    // depth only draws use the same indices
+    if (this->position_vao != 0) {
+        glBindVertexArray(this->position_vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ebo);
     }
 }
 
+ModelOptions Model::getVertexLayout() const {
+    return static_cast<ModelOptions>(this->model_options & VertexFormat::LAYOUT_MASK);
+}
+
 bool Model::isTextured() const {
     return this->model_options & ModelOptions::TEXTURED_UV || this->model_options & ModelOptions::SKYBOX;
 }
 
 Model::~Model() {
+    glDeleteBuffers(1, &this->ebo);
     glDeleteBuffers(1, &this->vbo);
     glDeleteVertexArrays(1, &this->vao);
+    glDeleteBuffers(1, &this->position_vbo);
+    glDeleteVertexArrays(1, &this->position_vao);
 }
 
 void Model::draw() const {
+    submit(this->vao);
+}
+
+void Model::drawPositions() const {
+    if (this->position_vao == 0)
+        throw std::runtime_error("Model::drawPositions: Model was not created with ModelOptions::POSITION_STREAM");
+    submit(this->position_vao);
+}
+
+void Model::submit(GLuint vertex_array) const {
     auto draw_type = this->isStrip() ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
 
-    glBindVertexArray(this->vao);
+    glBindVertexArray(vertex_array);
+    auto& stats = RenderStats::counters();
+    stats.draw_calls++;
+    if (isIndexed()) {
+        glDrawElements(draw_type, this->indices_count, this->index_type, nullptr);
+        stats.vertices += this->indices_count;
+        return;
+    }
     glDrawArrays(draw_type, 0, this->vertices_count);
+    stats.vertices += this->vertices_count;
+}
+
+void Model::drawInstanced(GLsizei instance_count) const {
+    auto draw_type = this->isStrip() ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
+
+    glBindVertexArray(this->vao);
+    auto& stats = RenderStats::counters();
+    stats.draw_calls++;
+    stats.instanced_draw_calls++;
+    if (isIndexed()) {
+        glDrawElementsInstanced(draw_type, this->indices_count, this->index_type, nullptr, instance_count);
+        stats.vertices += static_cast<uint64_t>(this->indices_count) * instance_count;
+        return;
+    }
+    glDrawArraysInstanced(draw_type, 0, this->vertices_count, instance_count);
+    stats.vertices += static_cast<uint64_t>(this->vertices_count) * instance_count;
 }
 
 int Model::getStrideFromOptions(ModelOptions options) {
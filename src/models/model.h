@@ -17,10 +17,14 @@
 #include "glm/gtc/matrix_transform.hpp" // glm::translate, glm::rotate, glm::scale, glm::perspective
 #include "glm/gtc/type_ptr.hpp" // glm::value_ptr
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <array>
 #include "../util/observer.h"
+#include "properties/bounds.h"
+
+struct MeshData;
 
 enum ModelOptions {
     UNKNOWN = 0,
@@ -28,7 +32,15 @@ enum ModelOptions {
     NORMALS = (1u << 1),
     TEXTURED_UV = (1u << 3),
     SKYBOX = (1u << 4),
-    STRIP = (1u << 5)
+    STRIP = (1u << 5),
+    // compressed vertex formats, see VertexFormat
+    HALF_POSITIONS = (1u << 6),
+    QUANTIZED_POSITIONS = (1u << 7), // normalized int16 inside the bounds, undone by getDequantization()
+    PACKED_NORMALS = (1u << 8), // GL_INT_2_10_10_10_REV
+    QUANTIZED_UV = (1u << 9), // normalized uint16, UVs outside [0, 1] fall back to HALF_UV
+    HALF_UV = (1u << 10),
+    // extra VAO reading only positions from their own tightly packed buffer, for depth only passes
+    POSITION_STREAM = (1u << 11)
 };
 
 class Model {
@@ -37,7 +49,22 @@ protected:
 
     GLuint vao = 0;
     GLuint vbo = 0;
-    GLsizei vertices_count;
+    GLsizei vertices_count = 0;
+    // element buffer, 0 for unindexed models drawn with glDrawArrays
+    GLuint ebo = 0;
+    GLsizei indices_count = 0;
+    // GL_UNSIGNED_SHORT whenever the vertex count allows it
+    GLenum index_type = GL_NONE;
+    // floats per vertex of the source data
+    GLsizei stride = 6;
+    // bytes per vertex in the vertex buffer, smaller than the source with the compressed formats
+    GLsizei vertex_size = 6 * sizeof(float);
+    // QUANTIZED_POSITIONS only, draws apply it on top of the model matrix
+    glm::mat4 dequantization = glm::mat4(1.f);
+
+    // POSITION_STREAM only
+    GLuint position_vao = 0;
+    GLuint position_vbo = 0;
 
     // shader names that are used for this model
     std::string vertex_shader_name;
@@ -45,17 +72,50 @@ protected:
 
     // gl draw type
     ModelOptions model_options = ModelOptions::UNKNOWN;
+
+    // local space bounds, used for culling
+    Bounds bounds;
+private:
+    void submit(GLuint vertex_array) const;
 public:
+    // placeholder without any buffers, filled in by upload() once the mesh is loaded (see AsyncLoader)
     Model() = default;
     ~Model();
 
     explicit Model(const float* vertices, int total_count);
     explicit Model(const float* vertices, int total_count, ModelOptions options);
+    // already indexed geometry, vertices are laid out as options say
+    Model(const float* vertices, int vertex_count, const uint32_t* indices, int index_count, ModelOptions options);
+    // encoded geometry, e.g. straight from a mapped MeshFile
+    explicit Model(const MeshData& mesh);
+
+    // creates the buffers of a placeholder, needs the GL context
+    void upload(const MeshData& mesh);
 
+    // false for a placeholder, it must not be drawn yet
+    [[nodiscard]] bool isLoaded() const { return this->vao != 0; }
     [[nodiscard]] bool isTextured () const;
     [[nodiscard]] bool isStrip () const { return this->model_options & ModelOptions::STRIP; }
+    [[nodiscard]] GLuint getVAO() const { return this->vao; }
+    [[nodiscard]] GLuint getVBO() const { return this->vbo; }
+    [[nodiscard]] GLsizei getVertexCount() const { return this->vertices_count; }
+    [[nodiscard]] GLsizei getStride() const { return this->stride; }
+    [[nodiscard]] GLsizei getVertexSize() const { return this->vertex_size; }
+    // options that describe the vertex buffer contents, see VertexFormat::LAYOUT_MASK
+    [[nodiscard]] ModelOptions getVertexLayout() const;
+    [[nodiscard]] bool isQuantized() const { return this->model_options & ModelOptions::QUANTIZED_POSITIONS; }
+    [[nodiscard]] const glm::mat4& getDequantization() const { return this->dequantization; }
+    [[nodiscard]] GLuint getPositionVAO() const { return this->position_vao; }
+    [[nodiscard]] bool isIndexed() const { return this->ebo != 0; }
+    [[nodiscard]] GLuint getEBO() const { return this->ebo; }
+    [[nodiscard]] GLsizei getIndexCount() const { return this->indices_count; }
+    [[nodiscard]] GLenum getIndexType() const { return this->index_type; }
+    [[nodiscard]] const Bounds& getBounds() const { return this->bounds; }
 
     void draw() const;
+    void drawInstanced(GLsizei instance_count) const;
+    // positions only through the POSITION_STREAM VAO, same primitives as draw()
+    void drawPositions() const;
 
     static int getStrideFromOptions(ModelOptions options);
 };
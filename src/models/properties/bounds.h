@@ -0,0 +1,70 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_BOUNDS_H
+#define ZPG_BOUNDS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include "glm/vec3.hpp"
+#include "glm/mat4x4.hpp"
+#include "glm/geometric.hpp"
+
+// local space bounds of a model, AABB and the bounding sphere around its center
+struct Bounds {
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+    glm::vec3 center = glm::vec3(0.0f);
+    float radius = 0.f;
+
+    // vertices are interleaved, position is always the first 3 floats of the vertex
+    static Bounds fromVertices(const float* vertices, int vertex_count, int stride) {
+        Bounds bounds;
+        if (vertex_count <= 0)
+            return bounds;
+
+        bounds.min = bounds.max = glm::vec3(vertices[0], vertices[1], vertices[2]);
+        for (int i = 1; i < vertex_count; i++) {
+            const float* v = vertices + static_cast<std::ptrdiff_t>(i) * stride;
+            glm::vec3 position(v[0], v[1], v[2]);
+            bounds.min = glm::min(bounds.min, position);
+            bounds.max = glm::max(bounds.max, position);
+        }
+
+        bounds.center = (bounds.min + bounds.max) * 0.5f;
+        float radius_sq = 0.f;
+        for (int i = 0; i < vertex_count; i++) {
+            const float* v = vertices + static_cast<std::ptrdiff_t>(i) * stride;
+            glm::vec3 offset = glm::vec3(v[0], v[1], v[2]) - bounds.center;
+            radius_sq = std::max(radius_sq, glm::dot(offset, offset));
+        }
+        bounds.radius = std::sqrt(radius_sq);
+        return bounds;
+    }
+
+    // world space AABB of the transformed box (Arvo)
+    void transformBox(const glm::mat4& matrix, glm::vec3& world_min, glm::vec3& world_max) const {
+        world_min = world_max = glm::vec3(matrix[3]);
+        for (int column = 0; column < 3; column++) {
+            for (int row = 0; row < 3; row++) {
+                float a = matrix[column][row] * min[column];
+                float b = matrix[column][row] * max[column];
+                world_min[row] += std::min(a, b);
+                world_max[row] += std::max(a, b);
+            }
+        }
+    }
+
+    // world space sphere, the radius is scaled by the largest axis scale of the matrix
+    void transformSphere(const glm::mat4& matrix, glm::vec3& world_center, float& world_radius) const {
+        world_center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+        float scale_sq = std::max({glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+                                   glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+                                   glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]))});
+        world_radius = radius * std::sqrt(scale_sq);
+    }
+};
+
+#endif //ZPG_BOUNDS_H
@@ -4,6 +4,7 @@
 
 #include <GL/glew.h>
 #include "texture.h"
+#include "../../util/render_stats.h"
 
 Texture::Texture(const TEXTURE_ID id) : texture_id(id), texture_unit(GL_TEXTURE0), target(GL_TEXTURE_2D) {
     glBindTexture(target, texture_id);
@@ -33,4 +34,5 @@ Texture::Texture(TEXTURE_ID id, GLenum unit, TEXTURE_TARGET bind_target) : textu
 void Texture::bind() const {
     glActiveTexture(texture_unit);
     glBindTexture(target, texture_id);
+    RenderStats::counters().texture_binds++;
 }
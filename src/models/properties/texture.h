@@ -18,6 +18,7 @@ public:
     explicit Texture(TEXTURE_ID id, GLenum unit, TEXTURE_TARGET bind_target);
 
     [[nodiscard]] TEXTURE_UNIT getTextureUnit() const { return (texture_unit - GL_TEXTURE0); }
+    [[nodiscard]] TEXTURE_ID getTextureId() const { return texture_id; }
 
     void bind() const;
 };
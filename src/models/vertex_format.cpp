@@ -0,0 +1,181 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <cstring>
+#include "glm/gtc/packing.hpp"
+#include "vertex_format.h"
+#include "../util/const.h"
+
+namespace {
+    // dequantization scale of flat axes, keeps the matrix invertible
+    constexpr float MIN_EXTENT = 1e-6f;
+
+    glm::vec3 getExtent(const Bounds& bounds) {
+        return glm::max(bounds.max - bounds.center, glm::vec3(MIN_EXTENT));
+    }
+
+    template<typename T>
+    void append(std::vector<uint8_t>& data, T value) {
+        size_t offset = data.size();
+        data.resize(offset + sizeof(T));
+        std::memcpy(&data[offset], &value, sizeof(T));
+    }
+
+    void appendPosition(std::vector<uint8_t>& data, ModelOptions options, const float* position,
+                        const glm::vec3& center, const glm::vec3& extent) {
+        if (options & ModelOptions::QUANTIZED_POSITIONS) {
+            for (int i = 0; i < 3; i++)
+                append(data, glm::packSnorm1x16((position[i] - center[i]) / extent[i]));
+            append<uint16_t>(data, 0); // padding, keeps vertices 4 byte aligned
+        } else if (options & ModelOptions::HALF_POSITIONS) {
+            for (int i = 0; i < 3; i++)
+                append(data, glm::packHalf1x16(position[i]));
+            append<uint16_t>(data, 0);
+        } else {
+            for (int i = 0; i < 3; i++)
+                append(data, position[i]);
+        }
+    }
+}
+
+ModelOptions VertexFormat::compress(ModelOptions options) {
+    if (!ENABLE_VERTEX_COMPRESSION)
+        return options;
+    return static_cast<ModelOptions>(options | ModelOptions::HALF_POSITIONS | ModelOptions::PACKED_NORMALS
+                                     | ModelOptions::QUANTIZED_UV);
+}
+
+ModelOptions VertexFormat::resolve(ModelOptions options, const float* vertices, int vertex_count) {
+    uint32_t resolved = options;
+    // the int16 grid is finer than half floats for any mesh size
+    if (resolved & ModelOptions::QUANTIZED_POSITIONS)
+        resolved &= ~ModelOptions::HALF_POSITIONS;
+    if (!(resolved & ModelOptions::NORMALS))
+        resolved &= ~ModelOptions::PACKED_NORMALS;
+    if (!(resolved & ModelOptions::TEXTURED_UV))
+        resolved &= ~(ModelOptions::QUANTIZED_UV | ModelOptions::HALF_UV);
+
+    if (resolved & ModelOptions::QUANTIZED_UV) {
+        const int stride = Model::getStrideFromOptions(options);
+        for (int i = 0; i < vertex_count; i++) {
+            const float* uv = vertices + static_cast<ptrdiff_t>(i) * stride + 6;
+            // repeating textures, the unit range cannot hold them
+            if (uv[0] < 0.0f || uv[0] > 1.0f || uv[1] < 0.0f || uv[1] > 1.0f) {
+                resolved = (resolved & ~ModelOptions::QUANTIZED_UV) | ModelOptions::HALF_UV;
+                break;
+            }
+        }
+    } else if (resolved & ModelOptions::HALF_UV) {
+        resolved &= ~ModelOptions::QUANTIZED_UV;
+    }
+    return static_cast<ModelOptions>(resolved);
+}
+
+bool VertexFormat::isCompressed(ModelOptions options) {
+    return options & (ModelOptions::HALF_POSITIONS | ModelOptions::QUANTIZED_POSITIONS | ModelOptions::PACKED_NORMALS
+                      | ModelOptions::QUANTIZED_UV | ModelOptions::HALF_UV);
+}
+
+GLsizei VertexFormat::getPositionSize(ModelOptions options) {
+    if (options & (ModelOptions::QUANTIZED_POSITIONS | ModelOptions::HALF_POSITIONS))
+        return 4 * sizeof(uint16_t);
+    return 3 * sizeof(float);
+}
+
+GLsizei VertexFormat::getVertexSize(ModelOptions options) {
+    GLsizei size = getPositionSize(options);
+    if (options & ModelOptions::NORMALS)
+        size += options & ModelOptions::PACKED_NORMALS ? sizeof(uint32_t) : 3 * sizeof(float);
+    if (options & ModelOptions::TEXTURED_UV)
+        size += options & (ModelOptions::QUANTIZED_UV | ModelOptions::HALF_UV) ? 2 * sizeof(uint16_t)
+                                                                              : 2 * sizeof(float);
+    return size;
+}
+
+void VertexFormat::setPositionAttribute(ModelOptions options, GLsizei vertex_size) {
+    glEnableVertexAttribArray(0);
+    if (options & ModelOptions::QUANTIZED_POSITIONS)
+        glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, vertex_size, (void*) 0);
+    else if (options & ModelOptions::HALF_POSITIONS)
+        glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, vertex_size, (void*) 0);
+    else
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertex_size, (void*) 0);
+}
+
+void VertexFormat::setAttributes(ModelOptions options) {
+    const GLsizei vertex_size = getVertexSize(options);
+    auto offset = static_cast<size_t>(getPositionSize(options));
+
+    setPositionAttribute(options, vertex_size);
+    if (options & ModelOptions::NORMALS) {
+        glEnableVertexAttribArray(1);
+        if (options & ModelOptions::PACKED_NORMALS) {
+            // packed formats always have 4 components, the shader reads xyz
+            glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, vertex_size, (void*) offset);
+            offset += sizeof(uint32_t);
+        } else {
+            glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, vertex_size, (void*) offset);
+            offset += 3 * sizeof(float);
+        }
+    }
+    if (options & ModelOptions::TEXTURED_UV) {
+        glEnableVertexAttribArray(2);
+        if (options & ModelOptions::QUANTIZED_UV)
+            glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, vertex_size, (void*) offset);
+        else if (options & ModelOptions::HALF_UV)
+            glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, vertex_size, (void*) offset);
+        else
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, vertex_size, (void*) offset);
+    }
+}
+
+std::vector<uint8_t> VertexFormat::encode(ModelOptions options, const float* vertices, int vertex_count,
+                                          const Bounds& bounds) {
+    const int stride = Model::getStrideFromOptions(options);
+    const glm::vec3 extent = getExtent(bounds);
+
+    std::vector<uint8_t> data;
+    data.reserve(static_cast<size_t>(vertex_count) * getVertexSize(options));
+    for (int i = 0; i < vertex_count; i++) {
+        const float* vertex = vertices + static_cast<ptrdiff_t>(i) * stride;
+        appendPosition(data, options, vertex, bounds.center, extent);
+
+        if (options & ModelOptions::PACKED_NORMALS) {
+            append(data, glm::packSnorm3x10_1x2(glm::vec4(vertex[3], vertex[4], vertex[5], 0.0f)));
+        } else if (options & ModelOptions::NORMALS) {
+            for (int j = 3; j < 6; j++)
+                append(data, vertex[j]);
+        }
+
+        if (options & ModelOptions::QUANTIZED_UV) {
+            append(data, glm::packUnorm1x16(vertex[6]));
+            append(data, glm::packUnorm1x16(vertex[7]));
+        } else if (options & ModelOptions::HALF_UV) {
+            append(data, glm::packHalf1x16(vertex[6]));
+            append(data, glm::packHalf1x16(vertex[7]));
+        } else if (options & ModelOptions::TEXTURED_UV) {
+            append(data, vertex[6]);
+            append(data, vertex[7]);
+        }
+    }
+    return data;
+}
+
+std::vector<uint8_t> VertexFormat::encodePositions(ModelOptions options, const float* vertices, int vertex_count,
+                                                   const Bounds& bounds) {
+    const int stride = Model::getStrideFromOptions(options);
+    const glm::vec3 extent = getExtent(bounds);
+
+    std::vector<uint8_t> data;
+    data.reserve(static_cast<size_t>(vertex_count) * getPositionSize(options));
+    for (int i = 0; i < vertex_count; i++)
+        appendPosition(data, options, vertices + static_cast<ptrdiff_t>(i) * stride, bounds.center, extent);
+    return data;
+}
+
+glm::mat4 VertexFormat::getDequantization(ModelOptions options, const Bounds& bounds) {
+    if (!(options & ModelOptions::QUANTIZED_POSITIONS))
+        return glm::mat4(1.0f);
+    return glm::scale(glm::translate(glm::mat4(1.0f), bounds.center), getExtent(bounds));
+}
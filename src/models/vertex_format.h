@@ -0,0 +1,56 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_VERTEX_FORMAT_H
+#define ZPG_VERTEX_FORMAT_H
+
+//Include GLEW
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <vector>
+#include "glm/mat4x4.hpp"
+#include "model.h"
+#include "properties/bounds.h"
+
+//
+// GPU side layout of model vertices. Models are always built from interleaved floats
+// (position, normal, uv), the compression bits of ModelOptions pick how each attribute is stored:
+// | position | float 12B, half 8B, int16 8B | normal | float 12B, 2_10_10_10 4B | uv | float 8B, uint16 or half 4B |
+// Every attribute still reaches the shaders as floats, so the shaders do not care about the format.
+//
+class VertexFormat {
+public:
+    // options bits that change the vertex layout, models with equal layouts can share buffers
+    static constexpr uint32_t LAYOUT_MASK = ModelOptions::VERTICES | ModelOptions::NORMALS | ModelOptions::TEXTURED_UV
+                                            | ModelOptions::HALF_POSITIONS | ModelOptions::QUANTIZED_POSITIONS
+                                            | ModelOptions::PACKED_NORMALS | ModelOptions::QUANTIZED_UV
+                                            | ModelOptions::HALF_UV;
+
+    // the compressed formats the model loaders use when ENABLE_VERTEX_COMPRESSION is set,
+    // half floats keep positions in model space, unlike QUANTIZED_POSITIONS they need no matrix from the draw
+    static ModelOptions compress(ModelOptions options);
+    // settles conflicting and data dependent bits, QUANTIZED_UV becomes HALF_UV when UVs leave [0, 1]
+    static ModelOptions resolve(ModelOptions options, const float* vertices, int vertex_count);
+    static bool isCompressed(ModelOptions options);
+
+    // bytes per vertex
+    static GLsizei getVertexSize(ModelOptions options);
+    static GLsizei getPositionSize(ModelOptions options);
+    // attributes 0 (position), 1 (normal) and 2 (uv) of the bound VAO, reading the bound GL_ARRAY_BUFFER
+    static void setAttributes(ModelOptions options);
+    static void setPositionAttribute(ModelOptions options, GLsizei vertex_size);
+
+    // vertices are interleaved floats with Model::getStrideFromOptions floats each
+    static std::vector<uint8_t> encode(ModelOptions options, const float* vertices, int vertex_count,
+                                       const Bounds& bounds);
+    // positions only, tightly packed
+    static std::vector<uint8_t> encodePositions(ModelOptions options, const float* vertices, int vertex_count,
+                                                const Bounds& bounds);
+    // model space position of QUANTIZED_POSITIONS vertices, identity for every other format
+    static glm::mat4 getDequantization(ModelOptions options, const Bounds& bounds);
+};
+
+
+#endif //ZPG_VERTEX_FORMAT_H
@@ -4,9 +4,34 @@
 
 #include "animation_manager.h"
 #include "../models/animations/centric_model.h"
+#include "../util/thread_pool.h"
 
 void AnimationManager::addAnimation(const std::shared_ptr<Animation>& animation) {
     animations.push_back(animation);
+    nodes_dirty = true;
+}
+
+void AnimationManager::flatten() {
+    nodes.clear();
+    for (const auto& animation: animations) {
+        if (auto* composite = dynamic_cast<CentricComposite*>(animation.get()))
+            composite->bfsTraverse([this](CentricModelComponent* component) { nodes.push_back(component); });
+        else
+            nodes.push_back(animation.get());
+    }
+    nodes_dirty = false;
+}
+
+void AnimationManager::stepAnimations(float delta_time) {
+    if (nodes_dirty)
+        flatten();
+
+    // a step only touches the local transform of its own node
+    ThreadPool::get().parallelFor(nodes.size(), ANIMATION_STEP_GRAIN, [this, delta_time](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            nodes[i]->step(delta_time);
+        }
+    });
 }
 
 void AnimationManager::applyAnimations(const std::function<void(Animation*)>& func) {
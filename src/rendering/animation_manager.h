@@ -15,9 +15,16 @@
 class AnimationManager {
 private:
     std::vector<std::shared_ptr<Animation>> animations;
+    // every node of every animation, including all nodes of the CentricComposite trees
+    std::vector<Animation*> nodes;
+    bool nodes_dirty = true;
+private:
+    void flatten();
 public:
     void addAnimation(const std::shared_ptr<Animation>& animation);
     void applyAnimations(const std::function<void(Animation*)>& func);
+    // steps all nodes on the thread pool, the matrices follow in TransformStore::update
+    void stepAnimations(float delta_time);
 
     // global objects components
     void translate(const glm::vec3& translation);
@@ -0,0 +1,276 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "bvh.h"
+
+//
+// AABB
+//
+
+AABB AABB::merge(const AABB& a, const AABB& b) {
+    return AABB{glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
+
+float AABB::area() const {
+    glm::vec3 d = max - min;
+    return 2.f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+bool AABB::contains(const AABB& other) const {
+    return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+           max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+}
+
+bool AABB::intersectsSphere(const glm::vec3& center, float radius) const {
+    glm::vec3 closest = glm::min(glm::max(center, min), max);
+    glm::vec3 d = closest - center;
+    return d.x * d.x + d.y * d.y + d.z * d.z <= radius * radius;
+}
+
+//
+// Node pool
+//
+
+BVH_NODE_ID DynamicBVH::allocateNode() {
+    if (!free_nodes.empty()) {
+        BVH_NODE_ID id = free_nodes.back();
+        free_nodes.pop_back();
+        nodes[id] = BVHNode{};
+        return id;
+    }
+    nodes.emplace_back();
+    return static_cast<BVH_NODE_ID>(nodes.size() - 1);
+}
+
+void DynamicBVH::freeNode(BVH_NODE_ID id) {
+    nodes[id] = BVHNode{};
+    free_nodes.push_back(id);
+}
+
+//
+// Incremental updates
+//
+
+void DynamicBVH::refitFrom(BVH_NODE_ID id) {
+    while (id != BVH_NULL_NODE) {
+        BVHNode& node = nodes[id];
+        node.box = AABB::merge(nodes[node.left].box, nodes[node.right].box);
+        id = node.parent;
+    }
+}
+
+void DynamicBVH::insertLeaf(BVH_NODE_ID leaf) {
+    if (root == BVH_NULL_NODE) {
+        root = leaf;
+        nodes[leaf].parent = BVH_NULL_NODE;
+        return;
+    }
+
+    // descend to the sibling with the lowest surface area cost
+    const AABB box = nodes[leaf].box;
+    BVH_NODE_ID index = root;
+    while (!nodes[index].isLeaf()) {
+        const BVHNode& node = nodes[index];
+        float area = node.box.area();
+        float combined_area = AABB::merge(node.box, box).area();
+
+        // cost of creating a new parent here, and the cost pushed down to the children
+        float cost = 2.f * combined_area;
+        float inheritance_cost = 2.f * (combined_area - area);
+
+        auto child_cost = [&](BVH_NODE_ID child) {
+            float merged = AABB::merge(box, nodes[child].box).area();
+            if (nodes[child].isLeaf())
+                return merged + inheritance_cost;
+            return merged - nodes[child].box.area() + inheritance_cost;
+        };
+        float cost_left = child_cost(node.left);
+        float cost_right = child_cost(node.right);
+
+        if (cost < cost_left && cost < cost_right)
+            break;
+        index = cost_left < cost_right ? node.left : node.right;
+    }
+
+    BVH_NODE_ID sibling = index;
+    BVH_NODE_ID old_parent = nodes[sibling].parent;
+    BVH_NODE_ID new_parent = allocateNode();
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].left = sibling;
+    nodes[new_parent].right = leaf;
+    nodes[new_parent].box = AABB::merge(box, nodes[sibling].box);
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+
+    if (old_parent == BVH_NULL_NODE) {
+        root = new_parent;
+    } else {
+        if (nodes[old_parent].left == sibling)
+            nodes[old_parent].left = new_parent;
+        else
+            nodes[old_parent].right = new_parent;
+        refitFrom(old_parent);
+    }
+}
+
+void DynamicBVH::removeLeaf(BVH_NODE_ID leaf) {
+    if (leaf == root) {
+        root = BVH_NULL_NODE;
+        return;
+    }
+
+    BVH_NODE_ID parent = nodes[leaf].parent;
+    BVH_NODE_ID grand_parent = nodes[parent].parent;
+    BVH_NODE_ID sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grand_parent != BVH_NULL_NODE) {
+        if (nodes[grand_parent].left == parent)
+            nodes[grand_parent].left = sibling;
+        else
+            nodes[grand_parent].right = sibling;
+        nodes[sibling].parent = grand_parent;
+        freeNode(parent);
+        refitFrom(grand_parent);
+    } else {
+        root = sibling;
+        nodes[sibling].parent = BVH_NULL_NODE;
+        freeNode(parent);
+    }
+    nodes[leaf].parent = BVH_NULL_NODE;
+}
+
+BVH_NODE_ID DynamicBVH::insert(DrawableObject* object, const AABB& box) {
+    BVH_NODE_ID leaf = allocateNode();
+    nodes[leaf].object = object;
+    nodes[leaf].object_box = box;
+    nodes[leaf].box = AABB{box.min - glm::vec3(FAT_MARGIN), box.max + glm::vec3(FAT_MARGIN)};
+    insertLeaf(leaf);
+
+    leaf_count++;
+    changes_since_rebuild++;
+    return leaf;
+}
+
+void DynamicBVH::remove(BVH_NODE_ID leaf) {
+    if (leaf < 0 || leaf >= static_cast<BVH_NODE_ID>(nodes.size()) || !nodes[leaf].isLeaf() ||
+        nodes[leaf].object == nullptr)
+        throw std::runtime_error("DynamicBVH::remove: Invalid leaf id");
+
+    removeLeaf(leaf);
+    freeNode(leaf);
+    leaf_count--;
+    changes_since_rebuild++;
+}
+
+bool DynamicBVH::update(BVH_NODE_ID leaf, const AABB& box) {
+    nodes[leaf].object_box = box;
+    // still inside the fat box, nothing to do
+    if (nodes[leaf].box.contains(box))
+        return false;
+
+    removeLeaf(leaf);
+    nodes[leaf].box = AABB{box.min - glm::vec3(FAT_MARGIN), box.max + glm::vec3(FAT_MARGIN)};
+    insertLeaf(leaf);
+    changes_since_rebuild++;
+    return true;
+}
+
+//
+// Rebuild
+//
+
+void DynamicBVH::rebuildIfNeeded() {
+    if (changes_since_rebuild > leaf_count && leaf_count > 1)
+        rebuild();
+}
+
+BVH_NODE_ID DynamicBVH::buildTopDown(std::vector<BVH_NODE_ID>& leaves, size_t begin, size_t end) {
+    if (end - begin == 1)
+        return leaves[begin];
+
+    // split at the median of the centroids along the widest axis
+    AABB bounds = nodes[leaves[begin]].box;
+    for (size_t i = begin + 1; i < end; i++) {
+        bounds = AABB::merge(bounds, nodes[leaves[i]].box);
+    }
+    glm::vec3 extent = bounds.max - bounds.min;
+    int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+    size_t middle = begin + (end - begin) / 2;
+    std::nth_element(leaves.begin() + static_cast<ptrdiff_t>(begin),
+                     leaves.begin() + static_cast<ptrdiff_t>(middle),
+                     leaves.begin() + static_cast<ptrdiff_t>(end),
+                     [this, axis](BVH_NODE_ID a, BVH_NODE_ID b) {
+                         return nodes[a].box.min[axis] + nodes[a].box.max[axis] <
+                                nodes[b].box.min[axis] + nodes[b].box.max[axis];
+                     });
+
+    BVH_NODE_ID left = buildTopDown(leaves, begin, middle);
+    BVH_NODE_ID right = buildTopDown(leaves, middle, end);
+
+    BVH_NODE_ID node = allocateNode();
+    nodes[node].left = left;
+    nodes[node].right = right;
+    nodes[node].box = bounds;
+    nodes[left].parent = node;
+    nodes[right].parent = node;
+    return node;
+}
+
+void DynamicBVH::rebuild() {
+    std::vector<BVH_NODE_ID> leaves;
+    leaves.reserve(leaf_count);
+
+    // collect the leaves, internal nodes are recreated below
+    std::vector<BVH_NODE_ID> stack;
+    if (root != BVH_NULL_NODE)
+        stack.push_back(root);
+    while (!stack.empty()) {
+        BVH_NODE_ID id = stack.back();
+        stack.pop_back();
+        if (nodes[id].isLeaf()) {
+            leaves.push_back(id);
+        } else {
+            stack.push_back(nodes[id].left);
+            stack.push_back(nodes[id].right);
+            freeNode(id);
+        }
+    }
+
+    changes_since_rebuild = 0;
+    if (leaves.empty()) {
+        root = BVH_NULL_NODE;
+        return;
+    }
+    root = buildTopDown(leaves, 0, leaves.size());
+    nodes[root].parent = BVH_NULL_NODE;
+}
+
+//
+// Queries
+//
+
+void DynamicBVH::queryFrustum(const Frustum& frustum, const std::function<void(DrawableObject*)>& func) const {
+    if (root == BVH_NULL_NODE)
+        return;
+
+    std::vector<BVH_NODE_ID> stack{root};
+    while (!stack.empty()) {
+        const BVHNode& node = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!frustum.testAABB(node.box.min, node.box.max))
+            continue;
+        if (node.isLeaf()) {
+            if (frustum.testAABB(node.object_box.min, node.object_box.max))
+                func(node.object);
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
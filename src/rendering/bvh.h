@@ -0,0 +1,80 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_BVH_H
+#define ZPG_BVH_H
+
+
+#include <functional>
+#include <vector>
+#include "glm/vec3.hpp"
+#include "../models/drawable.h"
+#include "frustum.h"
+
+struct AABB {
+    glm::vec3 min = glm::vec3(0.f);
+    glm::vec3 max = glm::vec3(0.f);
+
+    [[nodiscard]] static AABB merge(const AABB& a, const AABB& b);
+    [[nodiscard]] float area() const;
+    [[nodiscard]] bool contains(const AABB& other) const;
+    [[nodiscard]] bool intersectsSphere(const glm::vec3& center, float radius) const;
+};
+
+struct BVHNode {
+    // fattened box for leaves, union of the children for internal nodes
+    AABB box;
+    // exact world space box of the leaf object
+    AABB object_box;
+    DrawableObject* object = nullptr;
+    BVH_NODE_ID parent = BVH_NULL_NODE;
+    BVH_NODE_ID left = BVH_NULL_NODE;
+    BVH_NODE_ID right = BVH_NULL_NODE;
+
+    [[nodiscard]] bool isLeaf() const { return left == BVH_NULL_NODE; }
+};
+
+//
+// Dynamic AABB tree over world space object bounds.
+// Leaves store fattened boxes, so small movements only need a containment check,
+// larger ones remove and reinsert the leaf (best sibling by surface area).
+// After enough structural changes the tree is rebuilt top-down, leaf ids stay valid.
+//
+class DynamicBVH {
+public:
+    // leaf boxes are enlarged by this margin on each side
+    static constexpr float FAT_MARGIN = 0.5f;
+private:
+    std::vector<BVHNode> nodes;
+    std::vector<BVH_NODE_ID> free_nodes;
+    BVH_NODE_ID root = BVH_NULL_NODE;
+
+    size_t leaf_count = 0;
+    size_t changes_since_rebuild = 0;
+private:
+    BVH_NODE_ID allocateNode();
+    void freeNode(BVH_NODE_ID id);
+
+    void insertLeaf(BVH_NODE_ID leaf);
+    void removeLeaf(BVH_NODE_ID leaf);
+    void refitFrom(BVH_NODE_ID id);
+
+    BVH_NODE_ID buildTopDown(std::vector<BVH_NODE_ID>& leaves, size_t begin, size_t end);
+public:
+    BVH_NODE_ID insert(DrawableObject* object, const AABB& box);
+    void remove(BVH_NODE_ID leaf);
+    // returns true if the tree structure changed
+    bool update(BVH_NODE_ID leaf, const AABB& box);
+
+    // rebuild when the incremental changes outweigh the tree size
+    void rebuildIfNeeded();
+    void rebuild();
+
+    void queryFrustum(const Frustum& frustum, const std::function<void(DrawableObject*)>& func) const;
+
+    [[nodiscard]] size_t size() const { return leaf_count; }
+};
+
+
+#endif //ZPG_BVH_H
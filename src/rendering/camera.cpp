@@ -35,7 +35,7 @@ void Camera::move(const double& x_offset, const double& y_offset) {
 
     view = glm::lookAt(position, position + front, up);
 
-    notifyView();
+    is_dirty = true;
     notifyFlashlight();
 }
 
@@ -49,8 +49,7 @@ void Camera::moveCharacterSide(const float& offset) {
     position.y = y;
     view = glm::lookAt(position, position + front, CAMERA_UP);
 
-    notifyView();
-    notifyPosition();
+    is_dirty = true;
     notifyFlashlight();
 }
 
@@ -62,27 +61,41 @@ void Camera::moveCharacterFront(const float& offset) {
     position.y = y;
     view = glm::lookAt(position, position + front, CAMERA_UP);
 
-    notifyView();
-    notifyPosition();
+    is_dirty = true;
     notifyFlashlight();
 }
 
 void Camera::jumpProgress(const float& delta_time) {
-    if (is_jumping) {
-        current_jump_speed -= GRAVITY * delta_time;
-        position.y += current_jump_speed * delta_time;
-
-        // Check for landing
-        if (position.y <= GROUND_LEVEL) {
-            position.y = GROUND_LEVEL;
-            current_jump_speed = 0;
-            is_jumping = false;
-        }
+    // standing still, nothing to update
+    if (!is_jumping)
+        return;
+
+    current_jump_speed -= GRAVITY * delta_time;
+    position.y += current_jump_speed * delta_time;
+
+    // Check for landing
+    if (position.y <= GROUND_LEVEL) {
+        position.y = GROUND_LEVEL;
+        current_jump_speed = 0;
+        is_jumping = false;
     }
     view = glm::lookAt(position, position + front, CAMERA_UP);
 
-    notifyView();
-    notifyPosition();
+    is_dirty = true;
+    notifyFlashlight();
+}
+
+void Camera::lookAt(const glm::vec3& new_position, const glm::vec3& target) {
+    position = new_position;
+    front = glm::normalize(target - new_position);
+
+    // keep the angles in sync, so the mouse continues from this orientation
+    pitch = glm::degrees(asin(front.y));
+    yaw = glm::degrees(atan2(front.z, front.x));
+
+    view = glm::lookAt(position, position + front, CAMERA_UP);
+
+    is_dirty = true;
     notifyFlashlight();
 }
 
@@ -98,33 +111,36 @@ void Camera::update_aspect_ratio(const int& _width, const int& _height) {
     this->height = _height;
     aspect_ratio = (float) _width / (float) _height;
     projection = glm::perspective(PROJECTION_FOV, aspect_ratio, PROJECTION_NEAR, PROJECTION_FAR);
-
-    notifyProjection();
+    is_dirty = true;
 }
 
-void Camera::notifyView() {
-    EventPayload<const glm::mat4&> payload{view, EventType::U_VIEW_MATRIX};
-    notify(payload);
+void Camera::start() {
+    // previous scene camera might have taken over the binding point
+    block_buffer.bindBase();
+    is_dirty = true;
+    uploadBlock();
+    notifyFlashlight();
 }
 
-void Camera::notifyProjection() {
-    EventPayload<const glm::mat4&> payload{projection, EventType::U_PROJECTION_MATRIX};
-    notify(payload);
+void Camera::uploadBlock() {
+    if (updateBlock())
+        uploadBlock(block);
 }
 
-void Camera::notifyPosition() {
-    EventPayload<const glm::vec3&> payload{position, EventType::U_CAMERA_POSITION};
-    notify(payload);
-}
+bool Camera::updateBlock() {
+    if (!is_dirty)
+        return false;
 
-void Camera::notifyAll() {
-    notifyView();
-    notifyProjection();
-    notifyPosition();
+    block.view = view;
+    block.projection = projection;
+    block.view_projection = projection * view;
+    block.position = glm::vec4(position, 1.0f);
+    is_dirty = false;
+    return true;
 }
 
-void Camera::start() {
-    notifyAll();
+void Camera::uploadBlock(const CameraBlock& data) const {
+    block_buffer.update(0, sizeof(CameraBlock), &data);
 }
 
 void Camera::notifyFlashlight() {
@@ -176,4 +192,4 @@ glm::vec3 Camera::getWorldPosition(double x_pos, double y_pos, float depth) cons
     glm::vec3 screenX = glm::vec3(x, new_y, depth);
     glm::vec4 viewPort = glm::vec4(0, 0, this->getWidth(), this->getHeight());
     return glm::unProject(screenX, this->getView(), this->getProjection(), viewPort);
-}
\ No newline at end of file
+}
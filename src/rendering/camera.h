@@ -22,6 +22,15 @@
 #include "../util/const.h"
 #include "../util/observer.h"
 #include "light/spotlight.h"
+#include "../shaders/uniforms/uniform_buffer.h"
+
+// std140 layout of the Camera uniform block declared in the vertex shaders
+struct CameraBlock {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 view_projection;
+    glm::vec4 position;
+};
 
 class Camera : public ISubject {
 private:
@@ -31,6 +40,11 @@ private:
     glm::mat4 view;
     glm::mat4 projection;
 
+    // written once per frame, shared by all shaders
+    CameraBlock block{};
+    UniformBuffer block_buffer{sizeof(CameraBlock), CAMERA_BLOCK_BINDING};
+    bool is_dirty = true;
+
     double mouse_x;
     double mouse_y;
 
@@ -45,11 +59,6 @@ private:
 
     std::weak_ptr<Spotlight> flashlight;
 private:
-    void notifyAll();
-
-    void notifyView();
-    void notifyProjection();
-    void notifyPosition();
     void notifyFlashlight();
 public:
     explicit Camera(const int& init_width, const int& init_height);
@@ -77,10 +86,21 @@ public:
     void moveCharacterFront(const float& offset);
     void jump();
     void jumpProgress(const float& delta_time);
+    // place the camera explicitly, used by scripted camera paths
+    void lookAt(const glm::vec3& new_position, const glm::vec3& target);
+
+    // upload the uniform block if the camera changed since the last call
+    void uploadBlock();
+    // refresh the block data only, returns whether the camera changed since the last call
+    bool updateBlock();
+    // upload block data captured earlier, the render thread side of updateBlock
+    void uploadBlock(const CameraBlock& data) const;
+    [[nodiscard]] const CameraBlock& getBlock() const { return block; }
 
     [[nodiscard]] bool isJumping() const { return is_jumping; }
     [[nodiscard]] const glm::mat4& getView() const { return view; }
     [[nodiscard]] const glm::mat4& getProjection() const { return projection; }
+    [[nodiscard]] glm::mat4 getViewProjection() const { return projection * view; }
     [[nodiscard]] const glm::vec3& getPosition() const { return position; }
 };
 
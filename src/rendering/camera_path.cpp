@@ -0,0 +1,82 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "glm/common.hpp"
+#include "glm/trigonometric.hpp"
+
+#include "camera_path.h"
+
+CameraPath CameraPath::orbit(const glm::vec3& center, float radius, float height, int samples) {
+    CameraPath path;
+    for (int i = 0; i <= samples; i++) {
+        float t = static_cast<float>(i) / static_cast<float>(samples);
+        float angle = t * glm::radians(360.f);
+        glm::vec3 position = center + glm::vec3(std::cos(angle) * radius, height, std::sin(angle) * radius);
+        path.add({t, position, center});
+    }
+    return path;
+}
+
+CameraPath CameraPath::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open())
+        throw std::runtime_error("CameraPath::load: Cannot open " + path);
+
+    CameraPath camera_path;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream stream(line);
+        CameraKeyframe keyframe{};
+        stream >> keyframe.time
+               >> keyframe.position.x >> keyframe.position.y >> keyframe.position.z
+               >> keyframe.target.x >> keyframe.target.y >> keyframe.target.z;
+        if (stream.fail())
+            throw std::runtime_error("CameraPath::load: Malformed keyframe \"" + line + "\" in " + path);
+        camera_path.add(keyframe);
+    }
+
+    if (camera_path.empty())
+        throw std::runtime_error("CameraPath::load: No keyframes in " + path);
+    return camera_path;
+}
+
+void CameraPath::add(const CameraKeyframe& keyframe) {
+    if (!keyframes.empty() && keyframe.time < keyframes.back().time)
+        throw std::runtime_error("CameraPath::add: Keyframes out of order");
+    keyframes.push_back(keyframe);
+}
+
+void CameraPath::sample(float progress, glm::vec3& position, glm::vec3& target) const {
+    if (keyframes.empty())
+        throw std::runtime_error("CameraPath::sample: Empty path");
+
+    const float start = keyframes.front().time;
+    const float end = keyframes.back().time;
+    const float time = start + std::clamp(progress, 0.f, 1.f) * (end - start);
+
+    // first keyframe past the sampled time
+    auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+                                 [](float t, const CameraKeyframe& keyframe) { return t < keyframe.time; });
+    if (next == keyframes.begin() || next == keyframes.end()) {
+        const auto& keyframe = next == keyframes.begin() ? keyframes.front() : keyframes.back();
+        position = keyframe.position;
+        target = keyframe.target;
+        return;
+    }
+
+    auto previous = next - 1;
+    float span = next->time - previous->time;
+    float t = span > 0.f ? (time - previous->time) / span : 0.f;
+    position = glm::mix(previous->position, next->position, t);
+    target = glm::mix(previous->target, next->target, t);
+}
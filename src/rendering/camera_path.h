@@ -0,0 +1,41 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_CAMERA_PATH_H
+#define ZPG_CAMERA_PATH_H
+
+#include <string>
+#include <vector>
+
+#include "glm/vec3.hpp"
+
+struct CameraKeyframe {
+    float time;
+    glm::vec3 position;
+    glm::vec3 target;
+};
+
+//
+// Scripted camera movement, keyframes are interpolated linearly.
+// Text files hold one keyframe per line: "time px py pz tx ty tz", lines starting with '#' are skipped.
+//
+class CameraPath {
+private:
+    std::vector<CameraKeyframe> keyframes;
+public:
+    // circle around the center in the XZ plane, looking at the center
+    static CameraPath orbit(const glm::vec3& center, float radius, float height, int samples = 32);
+    static CameraPath load(const std::string& path);
+
+    // keyframes have to be added in ascending time
+    void add(const CameraKeyframe& keyframe);
+    // progress 0..1 is stretched over the whole path
+    void sample(float progress, glm::vec3& position, glm::vec3& target) const;
+
+    [[nodiscard]] bool empty() const { return keyframes.empty(); }
+    [[nodiscard]] size_t size() const { return keyframes.size(); }
+};
+
+
+#endif //ZPG_CAMERA_PATH_H
@@ -0,0 +1,172 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "cluster_grid.h"
+
+ClusterGrid::ClusterGrid() {
+    cells.resize(CLUSTER_COUNT);
+    cluster_boxes.resize(CLUSTER_COUNT);
+}
+
+void ClusterGrid::setProjection(const glm::mat4& projection, float near_plane, float far_plane) {
+    near = near_plane;
+    far = far_plane;
+    projection_x = projection[0][0];
+    projection_y = projection[1][1];
+
+    // slice = log(depth / near) / log(far / near) * CLUSTER_GRID_Z
+    float log_ratio = std::log(far / near);
+    slice_scale = static_cast<float>(CLUSTER_GRID_Z) / log_ratio;
+    slice_bias = -static_cast<float>(CLUSTER_GRID_Z) * std::log(near) / log_ratio;
+
+    for (int z = 0; z < CLUSTER_GRID_Z; ++z) {
+        float depth_near = near * std::pow(far / near, static_cast<float>(z) / CLUSTER_GRID_Z);
+        float depth_far = near * std::pow(far / near, static_cast<float>(z + 1) / CLUSTER_GRID_Z);
+
+        for (int y = 0; y < CLUSTER_GRID_Y; ++y) {
+            float ndc_y0 = -1.f + 2.f * static_cast<float>(y) / CLUSTER_GRID_Y;
+            float ndc_y1 = -1.f + 2.f * static_cast<float>(y + 1) / CLUSTER_GRID_Y;
+
+            for (int x = 0; x < CLUSTER_GRID_X; ++x) {
+                float ndc_x0 = -1.f + 2.f * static_cast<float>(x) / CLUSTER_GRID_X;
+                float ndc_x1 = -1.f + 2.f * static_cast<float>(x + 1) / CLUSTER_GRID_X;
+
+                // tile edges scale linearly with depth, extremes lie on the near or far slice plane
+                AABB& box = cluster_boxes[clusterIndex(x, y, z)];
+                box.min.x = std::min(ndc_x0 * depth_near, ndc_x0 * depth_far) / projection_x;
+                box.max.x = std::max(ndc_x1 * depth_near, ndc_x1 * depth_far) / projection_x;
+                box.min.y = std::min(ndc_y0 * depth_near, ndc_y0 * depth_far) / projection_y;
+                box.max.y = std::max(ndc_y1 * depth_near, ndc_y1 * depth_far) / projection_y;
+                box.min.z = -depth_far;
+                box.max.z = -depth_near;
+            }
+        }
+    }
+}
+
+int ClusterGrid::slice(float depth) const {
+    int z = static_cast<int>(std::floor(std::log(depth) * slice_scale + slice_bias));
+    return std::clamp(z, 0, CLUSTER_GRID_Z - 1);
+}
+
+ClusterGrid::ClusterRange ClusterGrid::computeRange(const LightSphere& sphere) const {
+    ClusterRange range{};
+    range.valid = false;
+
+    float center_depth = -sphere.center.z;
+    float depth_min = center_depth - sphere.radius;
+    float depth_max = center_depth + sphere.radius;
+    if (depth_max < near || depth_min > far)
+        return range;
+
+    range.min[2] = slice(std::max(depth_min, near));
+    range.max[2] = slice(std::min(depth_max, far));
+
+    // project the corners of the sphere box, the part behind the near plane is pulled onto it
+    float ndc_min[2] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float ndc_max[2] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+    for (float depth: {std::max(depth_min, near), std::min(depth_max, far)}) {
+        for (float sign: {-1.f, 1.f}) {
+            float ndc_x = (sphere.center.x + sign * sphere.radius) * projection_x / depth;
+            float ndc_y = (sphere.center.y + sign * sphere.radius) * projection_y / depth;
+            ndc_min[0] = std::min(ndc_min[0], ndc_x);
+            ndc_max[0] = std::max(ndc_max[0], ndc_x);
+            ndc_min[1] = std::min(ndc_min[1], ndc_y);
+            ndc_max[1] = std::max(ndc_max[1], ndc_y);
+        }
+    }
+
+    const int tiles[2] = {CLUSTER_GRID_X, CLUSTER_GRID_Y};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (ndc_max[axis] < -1.f || ndc_min[axis] > 1.f)
+            return range;
+
+        auto tile = [&tiles, axis](float ndc) {
+            int t = static_cast<int>(std::floor((ndc + 1.f) * 0.5f * static_cast<float>(tiles[axis])));
+            return std::clamp(t, 0, tiles[axis] - 1);
+        };
+        range.min[axis] = tile(ndc_min[axis]);
+        range.max[axis] = tile(ndc_max[axis]);
+    }
+
+    range.valid = true;
+    return range;
+}
+
+template<typename Visitor>
+void ClusterGrid::forEachCluster(const LightSphere& sphere, const ClusterRange& range, Visitor&& visitor) const {
+    if (!range.valid)
+        return;
+
+    for (int z = range.min[2]; z <= range.max[2]; ++z) {
+        for (int y = range.min[1]; y <= range.max[1]; ++y) {
+            for (int x = range.min[0]; x <= range.max[0]; ++x) {
+                int cluster = clusterIndex(x, y, z);
+                if (cluster_boxes[cluster].intersectsSphere(sphere.center, sphere.radius))
+                    visitor(cluster);
+            }
+        }
+    }
+}
+
+void ClusterGrid::build(const std::vector<LightSphere>& point_lights, const std::vector<LightSphere>& spotlights) {
+    std::fill(cells.begin(), cells.end(), ClusterCell{});
+
+    // count lights per cluster
+    point_ranges.resize(point_lights.size());
+    for (size_t i = 0; i < point_lights.size(); ++i) {
+        point_ranges[i] = computeRange(point_lights[i]);
+        forEachCluster(point_lights[i], point_ranges[i], [this](int cluster) {
+            cells[cluster].point_count++;
+        });
+    }
+    spot_ranges.resize(spotlights.size());
+    for (size_t i = 0; i < spotlights.size(); ++i) {
+        spot_ranges[i] = computeRange(spotlights[i]);
+        forEachCluster(spotlights[i], spot_ranges[i], [this](int cluster) {
+            cells[cluster].spot_count++;
+        });
+    }
+
+    // prefix sum into index list offsets, counts become write cursors for the second pass
+    GLuint offset = 0;
+    for (auto& cell: cells) {
+        cell.offset = offset;
+        offset += cell.point_count + cell.spot_count;
+        cell.point_count = 0;
+        cell.spot_count = 0;
+    }
+    indices.resize(offset);
+
+    // fill, point light indices first, spotlights after them once the point counts are final again
+    for (size_t i = 0; i < point_lights.size(); ++i) {
+        forEachCluster(point_lights[i], point_ranges[i], [this, i](int cluster) {
+            auto& cell = cells[cluster];
+            indices[cell.offset + cell.point_count++] = static_cast<GLuint>(i);
+        });
+    }
+    for (size_t i = 0; i < spotlights.size(); ++i) {
+        forEachCluster(spotlights[i], spot_ranges[i], [this, i](int cluster) {
+            auto& cell = cells[cluster];
+            indices[cell.offset + cell.point_count + cell.spot_count++] = static_cast<GLuint>(i);
+        });
+    }
+}
+
+void ClusterGrid::upload() {
+    upload(cells, indices);
+}
+
+void ClusterGrid::upload(const std::vector<ClusterCell>& cell_data, const std::vector<GLuint>& index_data) {
+    cell_buffer.upload(cell_data.data(), static_cast<GLsizeiptr>(cell_data.size() * sizeof(ClusterCell)));
+    index_buffer.upload(index_data.data(), static_cast<GLsizeiptr>(index_data.size() * sizeof(GLuint)));
+}
+
+void ClusterGrid::bind() const {
+    cell_buffer.bind(CLUSTER_TEXTURE_UNIT);
+    index_buffer.bind(LIGHT_INDEX_TEXTURE_UNIT);
+}
@@ -0,0 +1,96 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_CLUSTER_GRID_H
+#define ZPG_CLUSTER_GRID_H
+
+
+#include <vector>
+#include "glm/vec3.hpp"
+#include "glm/mat4x4.hpp"
+#include "bvh.h"
+#include "instance_buffer.h"
+#include "../util/const.h"
+
+// one texel of the cluster buffer texture (GL_RGBA32UI)
+struct ClusterCell {
+    GLuint offset = 0; // first entry in the light index list
+    GLuint point_count = 0; // point light indices, followed by
+    GLuint spot_count = 0; // spotlight indices
+    GLuint padding = 0;
+};
+
+// view space bounding sphere of a point or spotlight
+struct LightSphere {
+    glm::vec3 center;
+    float radius;
+};
+
+//
+// Froxel grid for clustered forward lighting. The view frustum is split into
+// CLUSTER_GRID_X * CLUSTER_GRID_Y screen tiles and CLUSTER_GRID_Z exponential depth slices,
+// every cluster lists the point and spotlights whose influence sphere touches it.
+// Fragments look up their cluster and shade only those lights.
+//
+class ClusterGrid {
+public:
+    static constexpr int CLUSTER_COUNT = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+private:
+    // inclusive cluster coordinates touched by a light, shared by the counting and the filling pass
+    struct ClusterRange {
+        int min[3];
+        int max[3];
+        bool valid;
+    };
+
+    float near = PROJECTION_NEAR;
+    float far = PROJECTION_FAR;
+    float slice_scale = 0.f;
+    float slice_bias = 0.f;
+    // projection[0][0] and projection[1][1] of a symmetric perspective projection
+    float projection_x = 1.f;
+    float projection_y = 1.f;
+
+    // view space bounds of each cluster, rebuilt when the projection changes
+    std::vector<AABB> cluster_boxes;
+
+    std::vector<ClusterCell> cells;
+    std::vector<GLuint> indices;
+    std::vector<ClusterRange> point_ranges;
+    std::vector<ClusterRange> spot_ranges;
+
+    InstanceBuffer cell_buffer{GL_RGBA32UI};
+    InstanceBuffer index_buffer{GL_R32UI};
+private:
+    [[nodiscard]] static int clusterIndex(int x, int y, int z) {
+        return x + CLUSTER_GRID_X * (y + CLUSTER_GRID_Y * z);
+    }
+    [[nodiscard]] int slice(float depth) const;
+    [[nodiscard]] ClusterRange computeRange(const LightSphere& sphere) const;
+
+    template<typename Visitor>
+    void forEachCluster(const LightSphere& sphere, const ClusterRange& range, Visitor&& visitor) const;
+public:
+    ClusterGrid();
+
+    void setProjection(const glm::mat4& projection, float near_plane, float far_plane);
+    // spheres are in view space, light indices are positions in the respective vectors
+    void build(const std::vector<LightSphere>& point_lights, const std::vector<LightSphere>& spotlights);
+    void upload();
+    // tables of an earlier build, captured by the thread that built them
+    void upload(const std::vector<ClusterCell>& cell_data, const std::vector<GLuint>& index_data);
+    void bind() const;
+
+    [[nodiscard]] const std::vector<ClusterCell>& getCells() const { return cells; }
+    [[nodiscard]] const std::vector<GLuint>& getIndices() const { return indices; }
+
+    [[nodiscard]] float getNear() const { return near; }
+    [[nodiscard]] float getFar() const { return far; }
+    [[nodiscard]] float getSliceScale() const { return slice_scale; }
+    [[nodiscard]] float getSliceBias() const { return slice_bias; }
+    [[nodiscard]] size_t getIndexCount() const { return indices.size(); }
+};
+
+
+#endif //ZPG_CLUSTER_GRID_H
@@ -0,0 +1,167 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include "frame_snapshot.h"
+#include "../util/render_stats.h"
+
+//
+// SnapshotDraw
+//
+
+const char* SnapshotDraw::getName() const {
+    if (pass == RenderPass::SKYBOX)
+        return "RenderItem::skybox";
+    switch (type) {
+        case RenderItemType::ANIMATION:
+            return "RenderItem::animation";
+        case RenderItemType::BATCH:
+            return "RenderItem::batch";
+        case RenderItemType::INDIRECT:
+            return "RenderItem::indirect";
+        default:
+            return "RenderItem::object";
+    }
+}
+
+void SnapshotDraw::notifyShader(Shader* shader) const {
+    if (type == RenderItemType::BATCH) {
+        batch->notifyShader();
+        return;
+    }
+    // everything else comes from the draw data storage buffer
+    if (type == RenderItemType::INDIRECT) {
+        if (texture != nullptr && (requirements & REQUIRES_TEXTURE))
+            shader->update(EventPayload<TEXTURE_UNIT>{texture->getTextureUnit(), EventType::U_TEXTURE_UNIT});
+        return;
+    }
+
+    // same events DrawableObject::notifyModelParameters sends, pointing into the snapshot
+    if (requirements & REQUIRES_MODEL_MATRIX)
+        shader->update(EventPayload<const glm::mat4*>{&model_matrix, EventType::U_MODEL_MATRIX});
+    if (requirements & REQUIRES_NORMAL_MATRIX)
+        shader->update(EventPayload<const glm::mat3*>{&normal_matrix, EventType::U_NORMAL_MATRIX});
+    if (requirements & REQUIRES_MATERIAL)
+        shader->update(EventPayload<const Material*>{&material, EventType::U_MATERIAL});
+    if (texture != nullptr && (requirements & REQUIRES_TEXTURE))
+        shader->update(EventPayload<TEXTURE_UNIT>{texture->getTextureUnit(), EventType::U_TEXTURE_UNIT});
+
+    if (type == RenderItemType::ANIMATION)
+        animation->notifyShader(*this);
+}
+
+void SnapshotDraw::draw() const {
+    switch (type) {
+        case RenderItemType::OBJECT:
+            if (stencil_id != 0) {
+                glStencilFunc(GL_ALWAYS, stencil_id, 0xFF);
+                RenderStats::counters().stencil_changes++;
+            }
+            if (texture != nullptr)
+                texture->bind();
+            model->draw();
+            break;
+        case RenderItemType::ANIMATION:
+            animation->draw();
+            break;
+        case RenderItemType::BATCH:
+            batch->draw();
+            break;
+        case RenderItemType::INDIRECT:
+            if (texture != nullptr)
+                texture->bind();
+            indirect->draw(*model, indirect_first, indirect_count);
+            break;
+    }
+}
+
+//
+// FrameSnapshot
+//
+
+void FrameSnapshot::clear() {
+    camera_dirty = false;
+    lights.clear();
+    draws.clear();
+    indirect_models.clear();
+    indirect_data.clear();
+    requirements = REQUIRES_NOTHING;
+}
+
+void FrameSnapshot::add(const RenderItem& item, SHADER_REQUIREMENTS shader_requirements) {
+    requirements |= shader_requirements;
+
+    SnapshotDraw& draw = draws.emplace_back();
+    draw.pass = item.pass;
+    draw.type = item.type;
+    draw.shader_alias = item.getShaderAlias();
+    draw.requirements = shader_requirements;
+    draw.stencil_id = item.getStencilID();
+
+    if (item.type == RenderItemType::BATCH) {
+        draw.batch = item.batch;
+        return;
+    }
+
+    const DrawableObject* object = item.object;
+    draw.model = object->getModel();
+    draw.model_matrix = object->getModelMatrix();
+    if (draw.model->isQuantized())
+        draw.model_matrix *= draw.model->getDequantization();
+    if (shader_requirements & REQUIRES_NORMAL_MATRIX)
+        draw.normal_matrix = object->getNormalMatrix();
+    if (shader_requirements & REQUIRES_MATERIAL)
+        draw.material = object->getMaterial();
+    draw.texture = draw.model->isTextured() ? object->getMaterial().texture : nullptr;
+
+    if (item.type == RenderItemType::ANIMATION) {
+        draw.animation = item.animation;
+        item.animation->capture(draw);
+    }
+}
+
+void FrameSnapshot::addIndirect(const RenderItem& item, SHADER_ALIAS_DATATYPE indirect_alias,
+                                SHADER_REQUIREMENTS shader_requirements, IndirectRenderer* renderer) {
+    requirements |= shader_requirements;
+
+    const DrawableObject* object = item.object;
+    const Model* model = object->getModel();
+    const Material& material = object->getMaterial();
+    const Texture* texture = model->isTextured() ? material.texture : nullptr;
+
+    // the render queue keeps objects of one shader and texture next to each other
+    SnapshotDraw* run = draws.empty() ? nullptr : &draws.back();
+    if (run == nullptr || run->type != RenderItemType::INDIRECT || run->pass != item.pass
+        || run->shader_alias != indirect_alias || run->texture != texture
+        || run->model->getVertexLayout() != model->getVertexLayout() || run->model->isStrip() != model->isStrip()
+        || run->model->isIndexed() != model->isIndexed()) {
+        run = &draws.emplace_back();
+        run->pass = item.pass;
+        run->type = RenderItemType::INDIRECT;
+        run->shader_alias = indirect_alias;
+        run->requirements = shader_requirements;
+        run->model = model;
+        run->texture = texture;
+        run->indirect = renderer;
+        run->indirect_first = static_cast<uint32_t>(indirect_models.size());
+    }
+    run->indirect_count++;
+
+    // same values DynamicUniforms::lazyPassMaterial and InstanceBatch::upload pass, see DrawData in *_indirect.vert
+    IndirectDrawData& data = indirect_data.emplace_back();
+    indirect_models.push_back(model);
+    // storage buffer members are not active uniforms, the requirements say nothing about the normal matrix
+    const glm::mat3& normal = object->getNormalMatrix();
+    data.model_matrix = object->getModelMatrix();
+    if (model->isQuantized())
+        data.model_matrix *= model->getDequantization();
+    data.normal_matrix[0] = glm::vec4(normal[0], 0.f);
+    data.normal_matrix[1] = glm::vec4(normal[1], 0.f);
+    data.normal_matrix[2] = glm::vec4(normal[2], 0.f);
+    data.ambient = glm::vec4(material.ambient, 0.f);
+    data.diffuse = glm::vec4(material.illuminated & ILLUMINATION::DIFFUSE ? material.diffuse : glm::vec3(0.f), 0.f);
+    if (material.illuminated & ILLUMINATION::SPECULAR)
+        data.specular = glm::vec4(material.specular, material.shininess);
+    else
+        data.specular = glm::vec4(glm::vec3(0.f), 1.f);
+}
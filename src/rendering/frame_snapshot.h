@@ -0,0 +1,80 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_FRAME_SNAPSHOT_H
+#define ZPG_FRAME_SNAPSHOT_H
+
+
+#include <vector>
+#include "glm/mat4x4.hpp"
+#include "glm/mat3x3.hpp"
+#include "render_queue.h"
+#include "camera.h"
+#include "light_manager.h"
+#include "indirect_renderer.h"
+#include "../shaders/shader.h"
+
+//
+// One visible render queue item with the state it is drawn with.
+// Matrices and material are copies, the scene may already move the object for the next frame.
+//
+struct SnapshotDraw {
+    RenderPass pass = RenderPass::OPAQUE;
+    RenderItemType type = RenderItemType::OBJECT;
+    SHADER_ALIAS_DATATYPE shader_alias = 0;
+    // of the shader, inputs it does not read are neither copied nor passed
+    SHADER_REQUIREMENTS requirements = REQUIRES_NOTHING;
+    char stencil_id = 0;
+
+    // OBJECT and ANIMATION, models and textures are never released while a scene runs
+    const Model* model = nullptr;
+    const Texture* texture = nullptr;
+    glm::mat4 model_matrix = glm::mat4(1.f);
+    glm::mat3 normal_matrix = glm::mat3(1.f);
+    Material material;
+
+    // draw themselves, batches are only rebuilt once no frame in flight references them
+    Animation* animation = nullptr;
+    InstanceBatch* batch = nullptr;
+    // INDIRECT, range of FrameSnapshot::indirect_models, model is the first one of the run
+    IndirectRenderer* indirect = nullptr;
+    uint32_t indirect_first = 0;
+    uint32_t indirect_count = 0;
+    // animation clock, see Animation::capture
+    float time = 0.f;
+
+    // profiler zone name
+    [[nodiscard]] const char* getName() const;
+
+    void notifyShader(Shader* shader) const;
+    void draw() const;
+};
+
+//
+// Everything the GL side needs to draw one frame: the culled and sorted draw list,
+// the camera block and the light data that changed. Written by Scene::simulate, consumed by Scene::render,
+// possibly on another thread (see RenderThread), so nothing in here points to mutable scene state.
+//
+struct FrameSnapshot {
+    bool camera_dirty = false;
+    CameraBlock camera{};
+    LightUpload lights;
+    std::vector<SnapshotDraw> draws;
+    // per object data of all INDIRECT draws, uploaded at once by IndirectRenderer::upload
+    std::vector<const Model*> indirect_models;
+    std::vector<IndirectDrawData> indirect_data;
+    // union over all draws, the light data is skipped if no drawn shader is lit
+    SHADER_REQUIREMENTS requirements = REQUIRES_NOTHING;
+
+    // keeps the allocations, snapshots are reused every frame
+    void clear();
+    void add(const RenderItem& item, SHADER_REQUIREMENTS shader_requirements);
+    // OBJECT items with an indirect shader variant, appended to the previous draw if it is a run
+    // with the same shader, texture and vertex layout
+    void addIndirect(const RenderItem& item, SHADER_ALIAS_DATATYPE indirect_alias,
+                     SHADER_REQUIREMENTS shader_requirements, IndirectRenderer* renderer);
+};
+
+
+#endif //ZPG_FRAME_SNAPSHOT_H
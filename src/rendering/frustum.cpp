@@ -0,0 +1,64 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <cmath>
+#include "frustum.h"
+
+void Frustum::update(const glm::mat4& view_projection) {
+    // glm is column major, rows of the matrix are combined
+    auto row = [&view_projection](int r) {
+        return glm::vec4(view_projection[0][r], view_projection[1][r], view_projection[2][r], view_projection[3][r]);
+    };
+    const glm::vec4 planes[PLANE_COUNT] = {
+            row(3) + row(0), // left
+            row(3) - row(0), // right
+            row(3) + row(1), // bottom
+            row(3) - row(1), // top
+            row(3) + row(2), // near
+            row(3) - row(2), // far
+    };
+
+    for (int i = 0; i < PLANE_COUNT; i++) {
+        float length = std::sqrt(planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z);
+        normal_x[i] = planes[i].x / length;
+        normal_y[i] = planes[i].y / length;
+        normal_z[i] = planes[i].z / length;
+        distance[i] = planes[i].w / length;
+    }
+}
+
+bool Frustum::testSphere(const glm::vec3& center, float radius) const {
+    for (int i = 0; i < PLANE_COUNT; i++) {
+        if (normal_x[i] * center.x + normal_y[i] * center.y + normal_z[i] * center.z + distance[i] < -radius)
+            return false;
+    }
+    return true;
+}
+
+bool Frustum::testAABB(const glm::vec3& min, const glm::vec3& max) const {
+    for (int i = 0; i < PLANE_COUNT; i++) {
+        // corner furthest along the plane normal
+        float x = normal_x[i] >= 0.f ? max.x : min.x;
+        float y = normal_y[i] >= 0.f ? max.y : min.y;
+        float z = normal_z[i] >= 0.f ? max.z : min.z;
+        if (normal_x[i] * x + normal_y[i] * y + normal_z[i] * z + distance[i] < 0.f)
+            return false;
+    }
+    return true;
+}
+
+void Frustum::testSpheres(const float* center_x, const float* center_y, const float* center_z, const float* radius,
+                          size_t count, uint8_t* visible) const {
+    for (size_t i = 0; i < count; i++) {
+        visible[i] = 1;
+    }
+
+    for (int p = 0; p < PLANE_COUNT; p++) {
+        const float nx = normal_x[p], ny = normal_y[p], nz = normal_z[p], d = distance[p];
+        for (size_t i = 0; i < count; i++) {
+            float dist = nx * center_x[i] + ny * center_y[i] + nz * center_z[i] + d;
+            visible[i] &= static_cast<uint8_t>(dist >= -radius[i]);
+        }
+    }
+}
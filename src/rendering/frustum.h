@@ -0,0 +1,41 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_FRUSTUM_H
+#define ZPG_FRUSTUM_H
+
+
+#include <array>
+#include <cstdint>
+#include "glm/vec3.hpp"
+#include "glm/mat4x4.hpp"
+
+//
+// View frustum planes extracted from the view-projection matrix (Gribb & Hartmann).
+// Planes are stored as structure of arrays and spheres are tested in batches,
+// plane by plane, so the inner loop is a plain multiply-add over contiguous floats
+// the compiler can vectorize.
+//
+class Frustum {
+public:
+    static constexpr int PLANE_COUNT = 6;
+private:
+    // plane normals point inside the frustum, distance >= 0 means inside
+    std::array<float, PLANE_COUNT> normal_x{};
+    std::array<float, PLANE_COUNT> normal_y{};
+    std::array<float, PLANE_COUNT> normal_z{};
+    std::array<float, PLANE_COUNT> distance{};
+public:
+    void update(const glm::mat4& view_projection);
+
+    [[nodiscard]] bool testSphere(const glm::vec3& center, float radius) const;
+    [[nodiscard]] bool testAABB(const glm::vec3& min, const glm::vec3& max) const;
+
+    // visible[i] is set to 1 if the i-th sphere intersects the frustum, 0 otherwise
+    void testSpheres(const float* center_x, const float* center_y, const float* center_z, const float* radius,
+                     size_t count, uint8_t* visible) const;
+};
+
+
+#endif //ZPG_FRUSTUM_H
@@ -0,0 +1,128 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <numeric>
+#include "indirect_renderer.h"
+#include "../util/const.h"
+#include "../util/render_stats.h"
+
+IndirectRenderer::IndirectRenderer() {
+    glGenBuffers(1, &this->draw_buffer);
+    glGenBuffers(1, &this->command_buffer);
+    glGenBuffers(1, &this->draw_id_buffer);
+}
+
+IndirectRenderer::~IndirectRenderer() {
+    glDeleteBuffers(1, &this->draw_buffer);
+    glDeleteBuffers(1, &this->command_buffer);
+    glDeleteBuffers(1, &this->draw_id_buffer);
+}
+
+bool IndirectRenderer::isSupported() {
+    return ENABLE_MULTI_DRAW_INDIRECT && GLEW_VERSION_4_3;
+}
+
+bool IndirectRenderer::accepts(const Model& model) {
+    return model.getStride() == 6 || model.getStride() == 8;
+}
+
+VertexArena& IndirectRenderer::getArena(const Model& model) {
+    auto& arena = arenas[model.getVertexLayout()];
+    if (!arena) {
+        arena = std::make_unique<VertexArena>(model.getVertexLayout());
+        // the VAO references the buffer object, growing its storage later needs no re-binding
+        arena->setDrawIDs(this->draw_id_buffer);
+    }
+    return *arena;
+}
+
+void IndirectRenderer::reserve(size_t draw_count) {
+    if (draw_count <= capacity)
+        return;
+    capacity = std::max(draw_count, capacity * 2);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->draw_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(IndirectDrawData)),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->command_buffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(DrawIndirectCommand)),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    // draw index n sits at index n, the base instance of a command picks it
+    std::vector<GLuint> draw_ids(capacity);
+    std::iota(draw_ids.begin(), draw_ids.end(), 0);
+    glBindBuffer(GL_ARRAY_BUFFER, this->draw_id_buffer);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(GLuint)), draw_ids.data(),
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void IndirectRenderer::upload(const std::vector<const Model*>& models, const std::vector<IndirectDrawData>& data) {
+    if (models.empty())
+        return;
+    reserve(models.size());
+
+    commands.resize(models.size());
+    for (size_t i = 0; i < models.size(); i++) {
+        const Model& model = *models[i];
+        ArenaRange range = getArena(model).place(model);
+        if (model.isIndexed()) {
+            commands[i] = DrawIndirectCommand{
+                    static_cast<GLuint>(model.getIndexCount()),
+                    1,
+                    static_cast<GLuint>(range.first_index),
+                    static_cast<GLuint>(range.first_vertex),
+                    static_cast<GLuint>(i),
+            };
+        } else {
+            commands[i] = DrawIndirectCommand{
+                    static_cast<GLuint>(model.getVertexCount()),
+                    1,
+                    static_cast<GLuint>(range.first_vertex),
+                    static_cast<GLuint>(i),
+                    0,
+            };
+        }
+    }
+
+    const auto data_size = static_cast<GLsizeiptr>(data.size() * sizeof(IndirectDrawData));
+    const auto command_size = static_cast<GLsizeiptr>(commands.size() * sizeof(DrawIndirectCommand));
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->draw_buffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, data_size, data.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    // stays bound for the draws, nothing else uses the indirect binding
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->command_buffer);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, command_size, commands.data());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_STORAGE_BINDING, this->draw_buffer);
+
+    auto& stats = RenderStats::counters();
+    stats.buffer_uploads += 2;
+    stats.buffer_upload_bytes += data_size + command_size;
+}
+
+void IndirectRenderer::draw(const Model& model, uint32_t first, uint32_t count) {
+    auto draw_type = model.isStrip() ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
+
+    const auto offset = (const void*) (first * sizeof(DrawIndirectCommand));
+    const auto command_stride = static_cast<GLsizei>(sizeof(DrawIndirectCommand));
+
+    // runs never mix indexed and unindexed models, see FrameSnapshot::addIndirect
+    getArena(model).bind();
+    if (model.isIndexed())
+        glMultiDrawElementsIndirect(draw_type, GL_UNSIGNED_INT, offset, static_cast<GLsizei>(count), command_stride);
+    else
+        glMultiDrawArraysIndirect(draw_type, offset, static_cast<GLsizei>(count), command_stride);
+
+    auto& stats = RenderStats::counters();
+    stats.draw_calls++;
+    stats.indirect_draw_calls++;
+    stats.indirect_commands += count;
+    for (uint32_t i = first; i < first + count; i++) {
+        stats.vertices += commands[i].count;
+    }
+}
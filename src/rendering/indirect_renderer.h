@@ -0,0 +1,83 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_INDIRECT_RENDERER_H
+#define ZPG_INDIRECT_RENDERER_H
+
+//Include GLEW
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+#include "vertex_arena.h"
+#include "../models/model.h"
+
+// per-draw data read by the *_indirect shaders, std430 layout of their DrawData struct
+struct IndirectDrawData {
+    glm::mat4 model_matrix;
+    // mat3 columns are padded to vec4 in std430
+    glm::vec4 normal_matrix[3];
+    glm::vec4 ambient;
+    glm::vec4 diffuse;
+    glm::vec4 specular; // w shininess
+};
+static_assert(sizeof(IndirectDrawData) == 160, "IndirectDrawData has to match the std430 layout of DrawData");
+
+// glMultiDrawElementsIndirect command layout, array commands use the first four words
+// (count, instance count, first vertex, base instance) and leave the fifth unused
+struct DrawIndirectCommand {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first;
+    GLuint base_vertex; // base instance of array commands
+    GLuint base_instance;
+};
+
+//
+// Submits runs of objects sharing an indirect shader, a texture and a vertex layout with one
+// glMultiDrawArraysIndirect or glMultiDrawElementsIndirect call each. All draws of a frame are uploaded
+// at once into a storage buffer (per-draw data) and an indirect buffer (one command per object),
+// the base instance of every command is its index into both, so the CPU cost of a run does not depend on how many objects it holds.
+// Geometry comes from VertexArena, one per vertex layout, so compressed models batch with each other.
+//
+class IndirectRenderer {
+private:
+    // created on the first model of every vertex layout
+    std::map<ModelOptions, std::unique_ptr<VertexArena>> arenas;
+
+    GLuint draw_buffer = 0;
+    GLuint command_buffer = 0;
+    GLuint draw_id_buffer = 0;
+    // in draws, all three buffers grow together
+    size_t capacity = 0;
+
+    std::vector<DrawIndirectCommand> commands;
+private:
+    VertexArena& getArena(const Model& model);
+    void reserve(size_t draw_count);
+public:
+    IndirectRenderer();
+    ~IndirectRenderer();
+
+    IndirectRenderer(const IndirectRenderer&) = delete;
+    IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+    // OpenGL 4.3 (multi draw indirect, storage buffers) and ENABLE_MULTI_DRAW_INDIRECT, valid after glewInit
+    static bool isSupported();
+    // the vertex layout of the model has an arena
+    static bool accepts(const Model& model);
+
+    // build the commands of every draw of the frame, upload them with their data and bind the buffers
+    // models and data are parallel, see FrameSnapshot::addIndirect
+    void upload(const std::vector<const Model*>& models, const std::vector<IndirectDrawData>& data);
+    // draws [first, first + count) of the last upload, model is any model of the run
+    void draw(const Model& model, uint32_t first, uint32_t count);
+};
+
+
+#endif //ZPG_INDIRECT_RENDERER_H
@@ -0,0 +1,74 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <limits>
+#include "instance_batch.h"
+
+void InstanceBatch::upload() {
+    texels.clear();
+    texels.reserve(objects.size() * INSTANCE_TEXELS);
+
+    for (const auto* object: objects) {
+        glm::mat4 model = object->getModelMatrix();
+        if (key.model->isQuantized())
+            model *= key.model->getDequantization();
+        const glm::mat3& normal = object->getNormalMatrix();
+        const Material& material = object->getMaterial();
+
+        texels.push_back(model[0]);
+        texels.push_back(model[1]);
+        texels.push_back(model[2]);
+        texels.push_back(model[3]);
+
+        texels.emplace_back(normal[0], 0.f);
+        texels.emplace_back(normal[1], 0.f);
+        texels.emplace_back(normal[2], 0.f);
+
+        // mirror DynamicUniforms::lazyPassMaterial, components not illuminated stay black
+        texels.emplace_back(material.ambient, 0.f);
+        texels.emplace_back(material.illuminated & ILLUMINATION::DIFFUSE ? material.diffuse : glm::vec3(0.f), 0.f);
+        if (material.illuminated & ILLUMINATION::SPECULAR)
+            texels.emplace_back(material.specular, material.shininess);
+        else
+            texels.emplace_back(glm::vec3(0.f), 1.f);
+    }
+
+    buffer.upload(texels);
+    updateBounds();
+}
+
+void InstanceBatch::updateBounds() {
+    if (objects.empty())
+        return;
+
+    // box around the instance spheres, then a sphere around the box
+    glm::vec3 box_min(std::numeric_limits<float>::max());
+    glm::vec3 box_max(-std::numeric_limits<float>::max());
+    for (const auto* object: objects) {
+        glm::vec3 center;
+        float radius;
+        key.model->getBounds().transformSphere(object->getModelMatrix(), center, radius);
+        box_min = glm::min(box_min, center - glm::vec3(radius));
+        box_max = glm::max(box_max, center + glm::vec3(radius));
+    }
+    bounds_center = (box_min + box_max) * 0.5f;
+    bounds_radius = glm::length(box_max - bounds_center);
+}
+
+void InstanceBatch::notifyShader() const {
+    if (key.texture != nullptr) {
+        notify(EventPayload<TEXTURE_UNIT>{key.texture->getTextureUnit(), EventType::U_TEXTURE_UNIT});
+    }
+    notify(EventPayload<TEXTURE_UNIT>{INSTANCE_TEXTURE_UNIT, EventType::U_INSTANCE_UNIT});
+}
+
+void InstanceBatch::draw() const {
+    if (objects.empty())
+        return;
+
+    if (key.texture != nullptr)
+        key.texture->bind();
+    buffer.bind(INSTANCE_TEXTURE_UNIT);
+    key.model->drawInstanced(static_cast<GLsizei>(objects.size()));
+}
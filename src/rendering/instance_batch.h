@@ -0,0 +1,63 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_INSTANCE_BATCH_H
+#define ZPG_INSTANCE_BATCH_H
+
+
+#include <vector>
+#include <tuple>
+#include "instance_buffer.h"
+#include "../models/drawable.h"
+#include "../util/observer.h"
+
+struct InstanceKey {
+    const Model* model;
+    SHADER_ALIAS_DATATYPE shader_alias;
+    const Texture* texture;
+
+    bool operator<(const InstanceKey& other) const {
+        return std::tie(model, shader_alias, texture) < std::tie(other.model, other.shader_alias, other.texture);
+    }
+};
+
+//
+// Group of static objects sharing a model, an instanced shader and a texture.
+// The whole group is drawn with a single glDrawArraysInstanced call.
+//
+class InstanceBatch : public ISubjectSingle {
+public:
+    // texels per instance, see the *_instanced.vert shaders
+    // [0..3] model matrix, [4..6] normal matrix, [7] ambient, [8] diffuse, [9] specular + shininess
+    static constexpr int INSTANCE_TEXELS = 10;
+private:
+    InstanceKey key;
+    std::vector<const DrawableObject*> objects;
+
+    std::vector<glm::vec4> texels;
+    InstanceBuffer buffer;
+
+    // world space sphere around all instances
+    glm::vec3 bounds_center = glm::vec3(0.f);
+    float bounds_radius = 0.f;
+private:
+    void updateBounds();
+public:
+    explicit InstanceBatch(const InstanceKey& key) : key(key) {}
+
+    void add(const DrawableObject* object) { objects.push_back(object); }
+    void upload();
+
+    [[nodiscard]] const InstanceKey& getKey() const { return key; }
+    [[nodiscard]] SHADER_ALIAS_DATATYPE getShaderAlias() const { return key.shader_alias; }
+    [[nodiscard]] size_t size() const { return objects.size(); }
+    [[nodiscard]] const glm::vec3& getBoundsCenter() const { return bounds_center; }
+    [[nodiscard]] float getBoundsRadius() const { return bounds_radius; }
+
+    void notifyShader() const;
+    void draw() const;
+};
+
+
+#endif //ZPG_INSTANCE_BATCH_H
@@ -0,0 +1,63 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <stdexcept>
+#include "instance_buffer.h"
+#include "../util/render_stats.h"
+
+InstanceBuffer::InstanceBuffer(GLenum format) : format(format) {
+    glGenBuffers(1, &this->buffer);
+    glGenTextures(1, &this->texture);
+}
+
+InstanceBuffer::~InstanceBuffer() {
+    glDeleteTextures(1, &this->texture);
+    glDeleteBuffers(1, &this->buffer);
+}
+
+void InstanceBuffer::upload(const std::vector<glm::vec4>& texels) {
+    upload(texels.data(), static_cast<GLsizeiptr>(texels.size() * sizeof(glm::vec4)));
+}
+
+void InstanceBuffer::upload(const void* data, GLsizeiptr size) {
+    if (size == 0)
+        return;
+
+    if (size > this->capacity) {
+        reserve(size);
+    }
+    update(0, size, data);
+}
+
+void InstanceBuffer::reserve(GLsizeiptr size) {
+    if (size <= this->capacity)
+        return;
+
+    // grow the storage and re-attach it to the buffer texture
+    glBindBuffer(GL_TEXTURE_BUFFER, this->buffer);
+    glBufferData(GL_TEXTURE_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_BUFFER, this->texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, this->format, this->buffer);
+    this->capacity = size;
+}
+
+void InstanceBuffer::update(GLintptr offset, GLsizeiptr size, const void* data) const {
+    if (offset + size > this->capacity)
+        throw std::runtime_error("InstanceBuffer::update: Write out of buffer bounds");
+
+    glBindBuffer(GL_TEXTURE_BUFFER, this->buffer);
+    glBufferSubData(GL_TEXTURE_BUFFER, offset, size, data);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    auto& stats = RenderStats::counters();
+    stats.buffer_uploads++;
+    stats.buffer_upload_bytes += size;
+}
+
+void InstanceBuffer::bind(TEXTURE_UNIT unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, this->texture);
+    RenderStats::counters().texture_binds++;
+}
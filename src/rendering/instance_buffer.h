@@ -0,0 +1,46 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_INSTANCE_BUFFER_H
+#define ZPG_INSTANCE_BUFFER_H
+
+//Include GLEW
+#include <GL/glew.h>
+
+#include <vector>
+#include "glm/vec4.hpp"
+#include "../util/const.h"
+
+//
+// Per-instance data stored in a buffer texture (GL_RGBA32F by default).
+// Shaders read it with texelFetch(samplerBuffer, gl_InstanceID * texels_per_instance + n),
+// so no per-model VAO has to be extended with instanced vertex attributes.
+// Also backs the clustered lighting tables, which use integer formats.
+//
+class InstanceBuffer {
+private:
+    GLuint buffer = 0;
+    GLuint texture = 0;
+    GLenum format;
+    GLsizeiptr capacity = 0;
+public:
+    explicit InstanceBuffer(GLenum format = GL_RGBA32F);
+    ~InstanceBuffer();
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    void upload(const std::vector<glm::vec4>& texels);
+    void upload(const void* data, GLsizeiptr size);
+    // grow the storage to at least size bytes, contents are undefined after growing
+    void reserve(GLsizeiptr size);
+    // write into already reserved storage
+    void update(GLintptr offset, GLsizeiptr size, const void* data) const;
+    void bind(TEXTURE_UNIT unit) const;
+
+    [[nodiscard]] GLsizeiptr getCapacity() const { return capacity; }
+};
+
+
+#endif //ZPG_INSTANCE_BUFFER_H
@@ -4,10 +4,9 @@
 
 #include "directional_light.h"
 
-std::array<LightProperty, 3> DirectionalLight::getParameters() const {
+DirectionalLightBlock DirectionalLight::pack() const {
     return {
-            LightProperty(&direction),
-            LightProperty(&color),
-            LightProperty(&intensity)
+            glm::vec4(direction, 0.f),
+            glm::vec4(color, intensity)
     };
-}
\ No newline at end of file
+}
@@ -6,7 +6,6 @@
 #define ZPG_DIRECTIONAL_LIGHT_H
 
 
-#include <tuple>
 #include "glm/vec3.hpp"
 #include "light.h"
 
@@ -21,15 +20,7 @@ public:
 
     [[nodiscard]] const glm::vec3& getDirection() const { return direction; }
 
-    static constexpr std::array<const char*, 3> getParameterNames() {
-        return std::array<const char*, 3>{
-                "direction",
-                "color",
-                "intensity"
-        };
-    }
-
-    [[nodiscard]] std::array<LightProperty, 3> getParameters() const;
+    [[nodiscard]] DirectionalLightBlock pack() const;
 };
 
 
@@ -2,11 +2,32 @@
 // E-Mail: sla0331@vsb.cz
 // Date of Creation:  3/11/2023
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 #include "light.h"
+#include "../../util/const.h"
 
 LIGHT_ID Light::getManagedId() const {
     if (this->managed_id == -1)
         throw std::runtime_error("Light has not been assigned a managed id");
     return this->managed_id;
 }
+
+float Light::influenceRadius(const Attenuation& attenuation) const {
+    // solve constant + linear * d + quadratic * d^2 = strength / threshold for d
+    float strength = intensity * std::max(color.x, std::max(color.y, color.z));
+    float target = strength / LIGHT_INFLUENCE_THRESHOLD - attenuation.constant;
+    if (target <= 0.f)
+        return 0.f;
+
+    if (attenuation.quadratic > 0.f) {
+        float discriminant = attenuation.linear * attenuation.linear + 4.f * attenuation.quadratic * target;
+        return (-attenuation.linear + std::sqrt(discriminant)) / (2.f * attenuation.quadratic);
+    }
+    if (attenuation.linear > 0.f)
+        return target / attenuation.linear;
+
+    // no falloff, reaches everything in view
+    return PROJECTION_FAR;
+}
@@ -5,26 +5,12 @@
 #ifndef ZPG_LIGHT_H
 #define ZPG_LIGHT_H
 
-#include <array>
-#include <vector>
-#include <string>
-#include <tuple>
-#include <variant>
 #include <GL/glew.h>
 #include "glm/vec3.hpp"
-#include "glm/ext/matrix_float3x3.hpp"
+#include "light_block.h"
 
 using LIGHT_ID = int;
 
-using LightProperty =
-        std::variant<
-                const glm::mat3*,
-                const glm::mat4*,
-                const glm::vec3*,
-                const GLint*,
-                const GLfloat*
-        >;
-
 struct Attenuation {
     float constant;
     float linear;
@@ -46,6 +32,9 @@ public:
 
     [[nodiscard]] const glm::vec3& getColor() const { return color; }
     [[nodiscard]] float getIntensity() const { return intensity; }
+
+    // distance at which the attenuated contribution drops below LIGHT_INFLUENCE_THRESHOLD
+    [[nodiscard]] float influenceRadius(const Attenuation& attenuation) const;
 };
 
 
@@ -0,0 +1,41 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_LIGHT_BLOCK_H
+#define ZPG_LIGHT_BLOCK_H
+
+
+#include "glm/vec4.hpp"
+
+//
+// Packed light records, must match the get*Light functions in the lit fragment shaders.
+// Directional lights live in the std140 Lights uniform block, point and spotlights
+// are texels of the light data buffer texture (3 and 4 texels per light).
+// Scalars are folded into the spare vec4 components.
+//
+
+struct PointLightBlock {
+    glm::vec4 position; // xyz position, w influence radius
+    glm::vec4 color; // rgb color, a intensity
+    glm::vec4 attenuation; // constant, linear, quadratic
+};
+
+struct DirectionalLightBlock {
+    glm::vec4 direction;
+    glm::vec4 color;
+};
+
+struct SpotLightBlock {
+    glm::vec4 position; // xyz position, w cutoff
+    glm::vec4 direction; // xyz direction, w outer cutoff
+    glm::vec4 color;
+    glm::vec4 attenuation; // constant, linear, quadratic, influence radius
+};
+
+static_assert(sizeof(PointLightBlock) == 3 * sizeof(glm::vec4), "PointLightBlock must be 3 texels");
+static_assert(sizeof(DirectionalLightBlock) == 32, "DirectionalLightBlock must follow std140 layout");
+static_assert(sizeof(SpotLightBlock) == 4 * sizeof(glm::vec4), "SpotLightBlock must be 4 texels");
+
+
+#endif //ZPG_LIGHT_BLOCK_H
@@ -4,13 +4,10 @@
 
 #include "point_light.h"
 
-std::array<LightProperty, 6> PointLight::getParameters() const {
+PointLightBlock PointLight::pack() const {
     return {
-            LightProperty(&position),
-            LightProperty(&color),
-            LightProperty(&intensity),
-            LightProperty(&attenuation.constant),
-            LightProperty(&attenuation.linear),
-            LightProperty(&attenuation.quadratic)
+            glm::vec4(position, influenceRadius(attenuation)),
+            glm::vec4(color, intensity),
+            glm::vec4(attenuation.constant, attenuation.linear, attenuation.quadratic, 0.f)
     };
 }
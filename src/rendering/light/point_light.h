@@ -33,18 +33,7 @@ public:
     [[nodiscard]] const glm::vec3& getPosition() const { return position; }
     [[nodiscard]] const Attenuation& getAttenuation() const { return attenuation; }
 
-    static constexpr std::array<const char*, 6> getParameterNames() {
-        return std::array<const char*, 6>{
-                "position",
-                "color",
-                "intensity",
-                "constant",
-                "linear",
-                "quadratic"
-        };
-    }
-
-    [[nodiscard]] std::array<LightProperty, 6> getParameters() const;
+    [[nodiscard]] PointLightBlock pack() const;
 };
 
 #endif //ZPG_POINT_LIGHT_H
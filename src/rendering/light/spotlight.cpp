@@ -4,16 +4,11 @@
 
 #include "spotlight.h"
 
-std::array<LightProperty, 9> Spotlight::getParameters() const {
+SpotLightBlock Spotlight::pack() const {
     return {
-            LightProperty(&position),
-            LightProperty(&direction),
-            LightProperty(&color),
-            LightProperty(&intensity),
-            LightProperty(&attenuation.constant),
-            LightProperty(&attenuation.linear),
-            LightProperty(&attenuation.quadratic),
-            LightProperty(&cutoff),
-            LightProperty(&outer_cutoff)
+            glm::vec4(position, cutoff),
+            glm::vec4(direction, outer_cutoff),
+            glm::vec4(color, intensity),
+            glm::vec4(attenuation.constant, attenuation.linear, attenuation.quadratic, influenceRadius(attenuation))
     };
-}
\ No newline at end of file
+}
@@ -41,22 +41,7 @@ public:
     [[nodiscard]] float getCutoff() const { return cutoff; }
     [[nodiscard]] float getOuterCutoff() const { return outer_cutoff; }
 
-
-    static constexpr std::array<const char*, 9> getParameterNames() {
-        return std::array<const char*, 9>{
-                "position",
-                "direction",
-                "color",
-                "intensity",
-                "constant",
-                "linear",
-                "quadratic",
-                "cutoff",
-                "outer_cutoff"
-        };
-    }
-
-    [[nodiscard]] std::array<LightProperty, 9> getParameters() const;
+    [[nodiscard]] SpotLightBlock pack() const;
 };
 
 
@@ -2,47 +2,242 @@
 // E-Mail: sla0331@vsb.cz
 // Date of Creation:  22/10/2023
 
+#include <cstdio>
+#include <cstring>
 #include "light_manager.h"
 #include "light/point_light.h"
 #include "light/directional_light.h"
 #include "light/spotlight.h"
 
-LightManager::LightManager() {
-    this->lights = std::make_shared<std::vector<std::shared_ptr<Light>>>();
+void LightUpload::clear() {
+    block_dirty = false;
+    records_dirty = false;
+    record_updates.clear();
+    clusters_dirty = false;
 }
 
-LIGHT_ID LightManager::addLight(const Light& light) {
-    auto light_id = static_cast<LIGHT_ID>(this->lights->size());
+static_assert(sizeof(LightsBlock) == DIRECTIONAL_CONFIG.max_count * sizeof(DirectionalLightBlock) +
+                                     sizeof(glm::ivec4) + 2 * sizeof(glm::vec4),
+              "LightsBlock must follow std140 layout");
 
+LIGHT_ID LightManager::addLight(const Light& light) {
     const auto* point_light = dynamic_cast<const PointLight*>(&light);
-    if (point_light != nullptr) {
-        this->lights->push_back(std::make_shared<PointLight>(*point_light));
-        this->lights->back()->setManagedId(static_cast<LIGHT_ID>(light_id));
-        return light_id;
-    }
+    if (point_light != nullptr)
+        return manage(std::make_shared<PointLight>(*point_light));
+
     const auto* directional_light = dynamic_cast<const DirectionalLight*>(&light);
-    if (directional_light != nullptr) {
-        this->lights->push_back(std::make_shared<DirectionalLight>(*directional_light));
-        this->lights->back()->setManagedId(static_cast<LIGHT_ID>(light_id));
-        return light_id;
-    }
+    if (directional_light != nullptr)
+        return manage(std::make_shared<DirectionalLight>(*directional_light));
+
     const auto* spot_light = dynamic_cast<const Spotlight*>(&light);
-    if (spot_light != nullptr) {
-        this->lights->push_back(std::make_shared<Spotlight>(*spot_light));
-        this->lights->back()->setManagedId(static_cast<LIGHT_ID>(light_id));
-        return light_id;
-    }
+    if (spot_light != nullptr)
+        return manage(std::make_shared<Spotlight>(*spot_light));
+
     return -1;
 }
 
 LIGHT_ID LightManager::addLight(const std::shared_ptr<Light>& light) {
-    auto light_id = static_cast<LIGHT_ID>(this->lights->size());
-    this->lights->push_back(light);
-    this->lights->back()->setManagedId(static_cast<LIGHT_ID>(light_id));
+    return manage(light);
+}
+
+LIGHT_ID LightManager::manage(const std::shared_ptr<Light>& light) {
+    auto light_id = static_cast<LIGHT_ID>(this->lights.size());
+    this->lights.push_back(light);
+    light->setManagedId(light_id);
+
+    // resolve the concrete type once, packing later on goes by the slot type
+    LightSlot slot;
+    if (dynamic_cast<const PointLight*>(light.get()) != nullptr) {
+        slot.type = LightType::POINT;
+        slot.index = static_cast<int>(point_lights.size());
+        point_lights.emplace_back();
+        point_spheres.emplace_back();
+        records_dirty = true;
+    } else if (dynamic_cast<const Spotlight*>(light.get()) != nullptr) {
+        slot.type = LightType::SPOT;
+        slot.index = static_cast<int>(spotlights.size());
+        spotlights.emplace_back();
+        spot_spheres.emplace_back();
+        records_dirty = true;
+    } else if (dynamic_cast<const DirectionalLight*>(light.get()) != nullptr) {
+        if (static_cast<size_t>(block.counts.y) < DIRECTIONAL_CONFIG.max_count) {
+            slot.type = LightType::DIRECTIONAL;
+            slot.index = block.counts.y++;
+            block_dirty = true;
+        } else {
+            // still managed (and reachable through getLight), just not visible to the shaders
+            printf("Too many %s in scene. Max is %zu.\n", DIRECTIONAL_CONFIG.name, DIRECTIONAL_CONFIG.max_count);
+        }
+    }
+
+    this->slots.push_back(slot);
+    markDirty(light_id);
     return light_id;
 }
 
-void LightManager::notifyShaders() {
-    EventPayload<std::shared_ptr<std::vector<std::shared_ptr<Light>>>> payload{this->lights, EventType::U_LIGHTS};
-    notify(payload);
+void LightManager::markDirty(LIGHT_ID id) {
+    auto& slot = slots.at(id);
+    if (slot.type == LightType::NONE || slot.is_dirty)
+        return;
+
+    slot.is_dirty = true;
+    dirty_lights.push_back(id);
+}
+
+void LightManager::pack(LIGHT_ID id, LightUpload& upload) {
+    const auto& slot = slots[id];
+    const Light* light = lights[id].get();
+    switch (slot.type) {
+        case LightType::POINT: {
+            auto& record = point_lights[slot.index] = static_cast<const PointLight*>(light)->pack();
+            point_spheres[slot.index].radius = record.position.w;
+            clusters_dirty = true;
+            // a full upload is pending anyway when the records moved
+            if (!records_dirty) {
+                auto& update = upload.record_updates.emplace_back();
+                update.offset = static_cast<GLintptr>(slot.index * sizeof(PointLightBlock));
+                update.size = sizeof(PointLightBlock);
+                std::memcpy(update.record, &record, sizeof(PointLightBlock));
+            }
+            break;
+        }
+        case LightType::SPOT: {
+            auto& record = spotlights[slot.index] = static_cast<const Spotlight*>(light)->pack();
+            spot_spheres[slot.index].radius = record.attenuation.w;
+            clusters_dirty = true;
+            if (!records_dirty) {
+                auto& update = upload.record_updates.emplace_back();
+                update.offset = static_cast<GLintptr>(point_lights.size() * sizeof(PointLightBlock) +
+                                                      slot.index * sizeof(SpotLightBlock));
+                update.size = sizeof(SpotLightBlock);
+                std::memcpy(update.record, &record, sizeof(SpotLightBlock));
+            }
+            break;
+        }
+        case LightType::DIRECTIONAL:
+            block.directional_lights[slot.index] = static_cast<const DirectionalLight*>(light)->pack();
+            block_dirty = true;
+            break;
+        default:
+            break;
+    }
+}
+
+void LightManager::packRecords(LightUpload& upload) {
+    upload.records_dirty = true;
+    upload.point_lights = point_lights;
+    upload.spotlights = spotlights;
+
+    block.counts.x = static_cast<int>(point_lights.size());
+    block.counts.z = static_cast<int>(spotlights.size());
+    block.counts.w = static_cast<int>(point_lights.size() * sizeof(PointLightBlock) / sizeof(glm::vec4));
+    block_dirty = true;
+    records_dirty = false;
+}
+
+void LightManager::updateProjection(const Camera& camera) {
+    if (camera.getWidth() == viewport_width && camera.getHeight() == viewport_height)
+        return;
+
+    viewport_width = camera.getWidth();
+    viewport_height = camera.getHeight();
+    clusters.setProjection(camera.getProjection(), PROJECTION_NEAR, PROJECTION_FAR);
+
+    block.cluster_depth = glm::vec4(clusters.getNear(), clusters.getFar(),
+                                    clusters.getSliceScale(), clusters.getSliceBias());
+    block.cluster_tile = glm::vec4(static_cast<float>(viewport_width) / CLUSTER_GRID_X,
+                                   static_cast<float>(viewport_height) / CLUSTER_GRID_Y, 0.f, 0.f);
+    block_dirty = true;
+    clusters_dirty = true;
+}
+
+void LightManager::buildClusters(const glm::mat4& view) {
+    for (size_t i = 0; i < point_lights.size(); ++i)
+        point_spheres[i].center = glm::vec3(view * glm::vec4(glm::vec3(point_lights[i].position), 1.f));
+    // cone is bounded by the sphere of its range
+    for (size_t i = 0; i < spotlights.size(); ++i)
+        spot_spheres[i].center = glm::vec3(view * glm::vec4(glm::vec3(spotlights[i].position), 1.f));
+
+    clusters.build(point_spheres, spot_spheres);
+    clustered_view = view;
+    clusters_dirty = false;
+}
+
+void LightManager::start(const Camera& camera) {
+    // previous scene might have taken over the binding point, the buffer keeps its contents
+    block_buffer.bindBase();
+    uploadBlock(camera);
+}
+
+void LightManager::uploadBlock(const Camera& camera) {
+    prepare(camera, pending);
+    upload(pending);
+}
+
+void LightManager::prepare(const Camera& camera, LightUpload& upload) {
+    upload.clear();
+    updateProjection(camera);
+
+    for (LIGHT_ID id: dirty_lights) {
+        pack(id, upload);
+        slots[id].is_dirty = false;
+    }
+    dirty_lights.clear();
+
+    if (records_dirty)
+        packRecords(upload);
+
+    if (clusters_dirty || camera.getView() != clustered_view) {
+        buildClusters(camera.getView());
+        upload.clusters_dirty = true;
+        upload.cluster_cells = clusters.getCells();
+        upload.cluster_indices = clusters.getIndices();
+    }
+
+    // small enough to go whole, changes only with directional lights, counts or the projection
+    if (block_dirty) {
+        upload.block_dirty = true;
+        upload.block = block;
+        block_dirty = false;
+    }
+}
+
+void LightManager::upload(const LightUpload& upload) {
+    if (upload.block_dirty)
+        block_buffer.update(0, sizeof(LightsBlock), &upload.block);
+
+    if (upload.records_dirty) {
+        auto point_size = static_cast<GLsizeiptr>(upload.point_lights.size() * sizeof(PointLightBlock));
+        auto spot_size = static_cast<GLsizeiptr>(upload.spotlights.size() * sizeof(SpotLightBlock));
+        if (point_size + spot_size > 0) {
+            light_buffer.reserve(point_size + spot_size);
+            if (point_size > 0)
+                light_buffer.update(0, point_size, upload.point_lights.data());
+            if (spot_size > 0)
+                light_buffer.update(point_size, spot_size, upload.spotlights.data());
+        }
+    }
+    for (const auto& update: upload.record_updates) {
+        light_buffer.update(update.offset, update.size, update.record);
+    }
+
+    if (upload.clusters_dirty)
+        clusters.upload(upload.cluster_cells, upload.cluster_indices);
+
+    bindTextures();
+}
+
+void LightManager::bindTextures() const {
+    light_buffer.bind(LIGHT_DATA_TEXTURE_UNIT);
+    clusters.bind();
+    // buffer texture uploads bind to the active unit, keep it away from the reserved ones
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void LightManager::update(const EventArgs& event_args) {
+    if (event_args.type != EventType::U_LIGHT_SINGLE)
+        return;
+
+    const auto* light_id = static_cast<const EventPayload<LIGHT_ID>*>(&event_args);
+    markDirty(light_id->getPayload());
 }
@@ -6,26 +6,140 @@
 #define ZPG_LIGHT_MANAGER_H
 
 
+#include <algorithm>
 #include <vector>
 #include <memory>
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
 #include "light/light.h"
+#include "light/light_block.h"
+#include "camera.h"
+#include "cluster_grid.h"
+#include "instance_buffer.h"
 #include "../util/observer.h"
 #include "../util/event_args.h"
+#include "../util/const.h"
 #include "../util/const_lights.h"
+#include "../shaders/uniforms/uniform_buffer.h"
 
-class LightManager : public ISubject {
+// std140 layout of the Lights uniform block declared in the lit fragment shaders
+struct LightsBlock {
+    DirectionalLightBlock directional_lights[DIRECTIONAL_CONFIG.max_count];
+    glm::ivec4 counts; // point, directional, spot, first spotlight texel
+    glm::vec4 cluster_depth; // near, far, slice scale, slice bias
+    glm::vec4 cluster_tile; // tile width, tile height in pixels
+};
+
+// single record rewritten in place, the bytes of either a point or a spotlight record
+struct LightRecordUpdate {
+    GLintptr offset;
+    GLsizeiptr size;
+    alignas(PointLightBlock) alignas(SpotLightBlock)
+    unsigned char record[std::max(sizeof(PointLightBlock), sizeof(SpotLightBlock))];
+};
+static_assert(sizeof(PointLightBlock) <= sizeof(LightRecordUpdate::record) &&
+              sizeof(SpotLightBlock) <= sizeof(LightRecordUpdate::record),
+              "LightRecordUpdate::record must fit every light record");
+
+// GL work collected by LightManager::prepare, applied by LightManager::upload
+struct LightUpload {
+    bool block_dirty = false;
+    LightsBlock block{};
+    // every point and spotlight record, after the light count changed
+    bool records_dirty = false;
+    std::vector<PointLightBlock> point_lights;
+    std::vector<SpotLightBlock> spotlights;
+    std::vector<LightRecordUpdate> record_updates;
+    bool clusters_dirty = false;
+    std::vector<ClusterCell> cluster_cells;
+    std::vector<GLuint> cluster_indices;
+
+    // keeps the allocations
+    void clear();
+};
+
+enum class LightType {
+    NONE,
+    POINT,
+    DIRECTIONAL,
+    SPOT,
+};
+
+// where a managed light lives, index into the directional block array or the point/spot records
+struct LightSlot {
+    LightType type = LightType::NONE;
+    int index = -1;
+    bool is_dirty = false;
+};
+
+//
+// Owns all scene lights. Directional lights are packed into a uniform block shared by every shader,
+// point and spotlights into a buffer texture that is culled into a froxel grid (see ClusterGrid),
+// so there is no upper limit on them.
+// Only lights marked dirty (new lights, flashlight moved by the camera) are re-packed and uploaded,
+// the clusters are rebuilt when the view or a clustered light changes, once per frame in uploadBlock().
+// uploadBlock() is split into prepare(), which needs no GL context, and upload(),
+// so that the packing and clustering can run on the simulation thread (see RenderThread).
+//
+class LightManager : public IObserver {
 private:
-    std::shared_ptr<std::vector<std::shared_ptr<Light>>> lights;
+    std::vector<std::shared_ptr<Light>> lights;
+    std::vector<LightSlot> slots; // indexed by LIGHT_ID
+
+    LightsBlock block{};
+    UniformBuffer block_buffer{sizeof(LightsBlock), LIGHTS_BLOCK_BINDING};
+
+    // spotlight records follow the point light records in the light buffer
+    std::vector<PointLightBlock> point_lights;
+    std::vector<SpotLightBlock> spotlights;
+    InstanceBuffer light_buffer;
+
+    ClusterGrid clusters;
+    std::vector<LightSphere> point_spheres;
+    std::vector<LightSphere> spot_spheres;
+    glm::mat4 clustered_view = glm::mat4(0.f);
+    int viewport_width = 0;
+    int viewport_height = 0;
+
+    std::vector<LIGHT_ID> dirty_lights;
+    // light count changed, spotlight records moved, upload all records
+    bool records_dirty = true;
+    bool clusters_dirty = true;
+    bool block_dirty = true;
+
+    // scratch of uploadBlock()
+    LightUpload pending;
+private:
+    LIGHT_ID manage(const std::shared_ptr<Light>& light);
+    void pack(LIGHT_ID id, LightUpload& upload);
+    void packRecords(LightUpload& upload);
+    void updateProjection(const Camera& camera);
+    void buildClusters(const glm::mat4& view);
 public:
-    LightManager();
-    ~LightManager() = default;
+    LightManager() = default;
+    ~LightManager() override = default;
 
     LIGHT_ID addLight(const Light& light);
     LIGHT_ID addLight(const std::shared_ptr<Light>& light);
 
-    [[nodiscard]] std::shared_ptr<Light> getLight(LIGHT_ID id) const { return this->lights->at(id); }
+    [[nodiscard]] std::shared_ptr<Light> getLight(LIGHT_ID id) const { return this->lights.at(id); }
+    [[nodiscard]] size_t size() const { return lights.size(); }
+    [[nodiscard]] size_t getClusterIndexCount() const { return clusters.getIndexCount(); }
+
+    // light parameters changed, re-pack it on the next upload
+    void markDirty(LIGHT_ID id);
+
+    // bind the buffers and upload pending lights, called when the scene is (re)entered
+    void start(const Camera& camera);
+    void uploadBlock(const Camera& camera);
+    // pack dirty lights and rebuild the clusters into upload, touches no GL state
+    void prepare(const Camera& camera, LightUpload& upload);
+    // apply a prepared upload and bind the light textures, on the thread owning the GL context
+    void upload(const LightUpload& upload);
+    void bindTextures() const;
 
-    void notifyShaders();
+    // U_LIGHT_SINGLE from the camera moving the flashlight
+    void update(const EventArgs& event_args) override;
 };
 
 
@@ -3,6 +3,8 @@
 // Date of Creation: 22/10/2023
 
 #include <algorithm>
+#include <map>
+#include <stdexcept>
 #include "object_manager.h"
 
 DrawableObject& ObjectManager::addObject(std::unique_ptr<DrawableObject> obj) {
@@ -19,15 +21,15 @@ DrawableObject& ObjectManager::assignSkybox(std::unique_ptr<DrawableObject> obj)
 // Preprocessing
 //
 
-void ObjectManager::sortObjects() {
-    std::sort(objects.begin(), objects.end(),
-              [](const std::unique_ptr<DrawableObject>& a, const std::unique_ptr<DrawableObject>& b) {
-                  return a->getShaderAlias() < b->getShaderAlias();
-              });
-}
-
-void ObjectManager::enqueue(ShaderLoader* shader_loader) {
+void ObjectManager::enqueue(ShaderLoader* shader_loader, RenderQueue& render_queue) {
+    std::vector<std::unique_ptr<DrawableObject>> waiting;
     for (auto& q_obj: queued_objects) {
+        // placeholder model still loading in the background, its bounds are not known yet
+        if (!q_obj->getModel()->isLoaded()) {
+            waiting.push_back(std::move(q_obj));
+            continue;
+        }
+
         // assign shader alias to the object
         if (int alias = shader_loader->getShaderAlias(q_obj->getShaderName()); alias == SHADER_UNLOADED)
             throw std::runtime_error(
@@ -35,13 +37,19 @@ void ObjectManager::enqueue(ShaderLoader* shader_loader) {
         else
             q_obj->assignShaderAlias(alias);
 
-        // load shader if not loaded yet
-        Shader* sh = shader_loader->loadShader(q_obj->getShaderAlias());
-        q_obj->attach(sh);
+        // static objects with an instanced shader variant are drawn in batches
+        // they are still part of the BVH for picking
+        if (getInstancedAlias(*q_obj, shader_loader) != SHADER_UNLOADED) {
+            q_obj->setBVHLeaf(bvh.insert(q_obj.get(), getWorldBox(*q_obj)));
+            instanced_objects.push_back(std::move(q_obj));
+            batches_dirty = true;
+            continue;
+        }
 
-        // make use of the loaded shader, and pre-pass uniforms just enough before the rendering loop
-        q_obj->notifyModel();
-        q_obj->notifyMaterial();
+        // uniforms are passed from the frame snapshot right before drawing
+        Shader* sh = shader_loader->getShader(q_obj->getShaderAlias());
+        q_obj->attach(sh);
+        q_obj->setShaderRequirements(sh->getRequirements());
 
         // assign interaction id to the object if it's marked as one
         if (q_obj->isInteract()) {
@@ -50,17 +58,75 @@ void ObjectManager::enqueue(ShaderLoader* shader_loader) {
         }
 
         // add object to the active scene
+        q_obj->setBVHLeaf(bvh.insert(q_obj.get(), getWorldBox(*q_obj)));
+        render_queue.insert(q_obj.get());
         objects.push_back(std::move(q_obj));
     }
 
-    // clear the queue
-    queued_objects.clear();
+    // only the waiting objects are left in the queue
+    queued_objects = std::move(waiting);
+    bvh.rebuildIfNeeded();
 }
 
-void ObjectManager::deleteObjects() {
+AABB ObjectManager::getWorldBox(const DrawableObject& object) {
+    AABB box;
+    object.getModel()->getBounds().transformBox(object.getModelMatrix(), box.min, box.max);
+    return box;
+}
+
+void ObjectManager::refitBVH() {
+    for (const auto& obj: objects) {
+        bvh.update(obj->getBVHLeaf(), getWorldBox(*obj));
+    }
+    for (const auto& obj: instanced_objects) {
+        bvh.update(obj->getBVHLeaf(), getWorldBox(*obj));
+    }
+    bvh.rebuildIfNeeded();
+    bvh_dirty = false;
+}
+
+SHADER_ALIAS_DATATYPE ObjectManager::getInstancedAlias(const DrawableObject& object, ShaderLoader* shader_loader) {
+    // interactive objects need their own stencil index, they can't share a draw call
+    if (!ENABLE_INSTANCING || object.isInteract())
+        return SHADER_UNLOADED;
+    return shader_loader->getShaderAlias(object.getShaderName() + INSTANCED_SHADER_SUFFIX);
+}
+
+void ObjectManager::rebuildBatches(ShaderLoader* shader_loader, RenderQueue& render_queue) {
+    std::map<InstanceKey, InstanceBatch*> batch_lookup;
+    for (const auto& batch: batches) {
+        render_queue.remove(batch.get());
+    }
+    batches.clear();
+
+    for (const auto& obj: instanced_objects) {
+        const Model* model = obj->getModel();
+        InstanceKey key{model,
+                        getInstancedAlias(*obj, shader_loader),
+                        model->isTextured() ? obj->getMaterial().texture : nullptr};
+
+        auto it = batch_lookup.find(key);
+        if (it == batch_lookup.end()) {
+            batches.push_back(std::make_unique<InstanceBatch>(key));
+            it = batch_lookup.emplace(key, batches.back().get()).first;
+        }
+        it->second->add(obj.get());
+    }
+
+    for (auto& batch: batches) {
+        batch->attach(shader_loader->getShader(batch->getShaderAlias()));
+        batch->upload();
+        render_queue.insert(batch.get());
+    }
+    batches_dirty = false;
+}
+
+void ObjectManager::deleteObjects(RenderQueue& render_queue) {
     for (auto& inter_id_obj: inter_ids_to_delete) {
         for (auto it = objects.begin(); it != objects.end(); ++it) {
             if ((*it)->isInteract() && (*it)->getInteractionID() == inter_id_obj) {
+                render_queue.remove(it->get());
+                bvh.remove((*it)->getBVHLeaf());
                 objects.erase(it);
                 break;
             }
@@ -69,14 +135,23 @@ void ObjectManager::deleteObjects() {
     inter_ids_to_delete.clear();
 }
 
-void ObjectManager::preprocess(ShaderLoader* shader_loader) {
+bool ObjectManager::hasPendingBatches() const {
+    return batches_dirty || std::any_of(queued_objects.begin(), queued_objects.end(),
+                                        [](const auto& obj) { return obj->getModel()->isLoaded(); });
+}
+
+void ObjectManager::preprocess(ShaderLoader* shader_loader, RenderQueue& render_queue) {
     if (!inter_ids_to_delete.empty())
-        deleteObjects();
+        deleteObjects(render_queue);
 
     if (!queued_objects.empty())
-        enqueue(shader_loader);
-    else
-        sortObjects();
+        enqueue(shader_loader, render_queue);
+
+    if (batches_dirty)
+        rebuildBatches(shader_loader, render_queue);
+
+    if (bvh_dirty)
+        refitBVH();
 }
 
 //
@@ -95,22 +170,39 @@ void ObjectManager::translate(const glm::vec3& translation) {
     for (auto& obj: objects) {
         obj->translate(translation);
     }
+    for (auto& obj: instanced_objects) {
+        obj->translate(translation);
+    }
+    batches_dirty = !instanced_objects.empty();
+    bvh_dirty = bvh.size() > 0;
 }
 
 void ObjectManager::rotate(const glm::vec3& axis_degrees) {
     for (auto& obj: objects) {
         obj->rotate(axis_degrees);
     }
+    for (auto& obj: instanced_objects) {
+        obj->rotate(axis_degrees);
+    }
+    batches_dirty = !instanced_objects.empty();
+    bvh_dirty = bvh.size() > 0;
 }
 
 void ObjectManager::scale(const glm::vec3& scale) {
     for (auto& obj: objects) {
         obj->scale(scale);
     }
+    for (auto& obj: instanced_objects) {
+        obj->scale(scale);
+    }
+    batches_dirty = !instanced_objects.empty();
+    bvh_dirty = bvh.size() > 0;
 }
 
 ObjectManager::~ObjectManager() {
+    batches.clear();
     objects.clear();
+    instanced_objects.clear();
     queued_objects.clear();
     inter_ids_to_delete.clear();
 }
\ No newline at end of file
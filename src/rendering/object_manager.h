@@ -7,6 +7,9 @@
 
 #include "../models/drawable.h"
 #include "../shaders/shader_loader.h"
+#include "instance_batch.h"
+#include "render_queue.h"
+#include "bvh.h"
 
 class ObjectManager {
 private:
@@ -14,16 +17,26 @@ private:
     std::unique_ptr<DrawableObject> skybox;
     // objects currently participating in rendering pipeline
     std::vector<std::unique_ptr<DrawableObject>> objects;
-    // not part of the scene yet
+    // objects drawn through instanced batches
+    std::vector<std::unique_ptr<DrawableObject>> instanced_objects;
+    std::vector<std::unique_ptr<InstanceBatch>> batches;
+    bool batches_dirty = false;
+    // world space bounds of the objects, refit after global transformations
+    DynamicBVH bvh;
+    bool bvh_dirty = false;
+    // not part of the scene yet, objects with a placeholder model wait here until it is loaded
     std::vector<std::unique_ptr<DrawableObject>> queued_objects;
     // prepared to be deleted
     std::vector<char> inter_ids_to_delete;
     // next interaction id
     char next_interact_id = 1;
 private:
-    void enqueue(ShaderLoader* shader_loader);
-    void sortObjects();
-    void deleteObjects();
+    void enqueue(ShaderLoader* shader_loader, RenderQueue& render_queue);
+    void deleteObjects(RenderQueue& render_queue);
+    void rebuildBatches(ShaderLoader* shader_loader, RenderQueue& render_queue);
+    void refitBVH();
+    static AABB getWorldBox(const DrawableObject& object);
+    static SHADER_ALIAS_DATATYPE getInstancedAlias(const DrawableObject& object, ShaderLoader* shader_loader);
 public:
     ~ObjectManager();
 
@@ -36,8 +49,13 @@ public:
     DrawableObject* getByInteractID(const char& id);
     void deleteByInteractID(const char& id);
 
-    // enqueue and sort objects by shader alias
-    void preprocess(ShaderLoader* shader_loader);
+    // enqueue and delete objects, keeping the render queue in sync
+    void preprocess(ShaderLoader* shader_loader, RenderQueue& render_queue);
+    // preprocess will (re)upload instance batches, which needs the GL context
+    [[nodiscard]] bool hasPendingBatches() const;
+
+    [[nodiscard]] const std::vector<std::unique_ptr<InstanceBatch>>& getBatches() const { return batches; }
+    [[nodiscard]] const DynamicBVH& getBVH() const { return bvh; }
 
     // global objects components
     void translate(const glm::vec3& translation);
@@ -0,0 +1,246 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <cstddef>
+#include "glm/geometric.hpp"
+#include "render_queue.h"
+
+//
+// RenderItem
+//
+
+SHADER_ALIAS_DATATYPE RenderItem::getShaderAlias() const {
+    if (type == RenderItemType::BATCH)
+        return batch->getShaderAlias();
+    return object->getShaderAlias();
+}
+
+const void* RenderItem::getOwner() const {
+    if (type == RenderItemType::BATCH)
+        return batch;
+    return object;
+}
+
+char RenderItem::getStencilID() const {
+    if (object != nullptr && object->isInteract())
+        return object->getInteractionID();
+    return 0;
+}
+
+//
+// Keys
+//
+
+RENDER_KEY RenderQueue::makeStateKey(const RenderItem& item) {
+    const Model* model;
+    const Texture* texture;
+    if (item.type == RenderItemType::BATCH) {
+        model = item.batch->getKey().model;
+        texture = item.batch->getKey().texture;
+    } else {
+        model = item.object->getModel();
+        texture = model->isTextured() ? item.object->getMaterial().texture : nullptr;
+    }
+
+    auto alias = static_cast<RENDER_KEY>(item.getShaderAlias());
+    RENDER_KEY texture_id = texture != nullptr ? texture->getTextureId() : 0;
+    RENDER_KEY vao = model->getVAO();
+
+    return (static_cast<RENDER_KEY>(item.pass) & PASS_MASK) << PASS_SHIFT |
+           (alias & SHADER_MASK) << SHADER_SHIFT |
+           (texture_id & TEXTURE_MASK) << TEXTURE_SHIFT |
+           (vao & VAO_MASK) << VAO_SHIFT;
+}
+
+RENDER_KEY RenderQueue::makeDepthKey(const RenderItem& item) const {
+    // batches are spread over the scene, skybox has no meaningful depth
+    if (item.type == RenderItemType::BATCH || item.pass == RenderPass::SKYBOX)
+        return 0;
+
+    // front to back, so that the early depth test rejects as much as possible
+    glm::vec3 position = glm::vec3(item.object->getModelMatrix()[3]);
+    float distance = glm::length(position - eye) / PROJECTION_FAR;
+    distance = std::clamp(distance, 0.f, 1.f);
+    return static_cast<RENDER_KEY>(distance * static_cast<float>(DEPTH_MASK)) & DEPTH_MASK;
+}
+
+//
+// Insertion and removal
+//
+
+void RenderQueue::queueInsert(RenderItem item) {
+    inserted.push_back(item);
+}
+
+void RenderQueue::queueRemove(const void* owner) {
+    // inserted during this frame, a new item may reuse the address of a removed one, so they are dropped right away
+    inserted.erase(std::remove_if(inserted.begin(), inserted.end(),
+                                  [owner](const RenderItem& item) { return item.getOwner() == owner; }),
+                   inserted.end());
+    removed.insert(owner);
+}
+
+void RenderQueue::insert(DrawableObject* object, RenderPass pass) {
+    queueInsert(RenderItem{.pass = pass, .type = RenderItemType::OBJECT, .object = object});
+}
+
+void RenderQueue::insert(Animation* animation) {
+    queueInsert(RenderItem{.type = RenderItemType::ANIMATION,
+                           .object = &animation->getDrawableObject(),
+                           .animation = animation});
+}
+
+void RenderQueue::insert(InstanceBatch* batch) {
+    queueInsert(RenderItem{.type = RenderItemType::BATCH, .batch = batch});
+}
+
+void RenderQueue::remove(const DrawableObject* object) {
+    queueRemove(object);
+}
+
+void RenderQueue::remove(const InstanceBatch* batch) {
+    queueRemove(batch);
+}
+
+void RenderQueue::clear() {
+    items.clear();
+    inserted.clear();
+    removed.clear();
+}
+
+void RenderQueue::applyChanges() {
+    // a single compacting pass, removed items are never dereferenced
+    if (!removed.empty()) {
+        items.erase(std::remove_if(items.begin(), items.end(),
+                                   [this](const RenderItem& item) { return removed.count(item.getOwner()) > 0; }),
+                    items.end());
+        removed.clear();
+    }
+
+    if (inserted.empty())
+        return;
+    for (auto& item: inserted) {
+        item.key = makeStateKey(item) | makeDepthKey(item);
+    }
+    std::sort(inserted.begin(), inserted.end(),
+              [](const RenderItem& a, const RenderItem& b) { return a.key < b.key; });
+    const size_t middle = items.size();
+    items.insert(items.end(), inserted.begin(), inserted.end());
+    std::inplace_merge(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(middle), items.end(),
+                       [](const RenderItem& a, const RenderItem& b) { return a.key < b.key; });
+    inserted.clear();
+}
+
+//
+// Per-frame update
+//
+
+void RenderQueue::updateDepth(const glm::vec3& camera_position) {
+    eye = camera_position;
+    applyChanges();
+    for (auto& item: items) {
+        item.key = (item.key & ~DEPTH_MASK) | makeDepthKey(item);
+    }
+
+    // state bits never change, so only items with similar state can swap places
+    // insertion sort is linear on such almost sorted data
+    const size_t budget = items.size() * RENDER_QUEUE_SORT_BUDGET;
+    size_t moves = 0;
+    for (size_t i = 1; i < items.size(); i++) {
+        RenderItem current = items[i];
+        size_t j = i;
+        while (j > 0 && items[j - 1].key > current.key) {
+            items[j] = items[j - 1];
+            j--;
+            moves++;
+        }
+        items[j] = current;
+
+        if (moves > budget) {
+            std::sort(items.begin(), items.end(),
+                      [](const RenderItem& a, const RenderItem& b) { return a.key < b.key; });
+            return;
+        }
+    }
+}
+
+void RenderQueue::updateState() {
+    applyChanges();
+    for (auto& item: items) {
+        item.key = makeStateKey(item) | (item.key & DEPTH_MASK);
+    }
+    std::sort(items.begin(), items.end(),
+              [](const RenderItem& a, const RenderItem& b) { return a.key < b.key; });
+}
+
+//
+// Culling
+//
+
+void RenderQueue::cull(const Frustum& frustum, const DynamicBVH& bvh) {
+    // frame 0 is never matched, objects start as not visited
+    if (++cull_frame == 0)
+        cull_frame = 1;
+    bvh.queryFrustum(frustum, [this](DrawableObject* object) {
+        object->markVisible(cull_frame);
+    });
+
+    cull_indices.clear();
+    cull_x.clear();
+    cull_y.clear();
+    cull_z.clear();
+    cull_radius.clear();
+
+    // gather world space spheres, items that can't be culled stay visible
+    for (size_t i = 0; i < items.size(); i++) {
+        auto& item = items[i];
+        item.visible = true;
+
+        // placeholder of a model still loading in the background, see AsyncLoader
+        if (item.type != RenderItemType::BATCH && !item.object->getModel()->isLoaded()) {
+            item.visible = false;
+            continue;
+        }
+
+        glm::vec3 center;
+        float radius;
+        if (item.pass == RenderPass::SKYBOX) {
+            continue;
+        } else if (item.type == RenderItemType::BATCH) {
+            center = item.batch->getBoundsCenter();
+            radius = item.batch->getBoundsRadius();
+        } else if (item.type == RenderItemType::ANIMATION && !item.animation->isCullable()) {
+            continue;
+        } else if (item.type == RenderItemType::OBJECT && item.object->getBVHLeaf() != BVH_NULL_NODE) {
+            item.visible = item.object->isVisible(cull_frame);
+            continue;
+        } else {
+            item.object->getModel()->getBounds().transformSphere(item.object->getModelMatrix(), center, radius);
+        }
+
+        cull_indices.push_back(i);
+        cull_x.push_back(center.x);
+        cull_y.push_back(center.y);
+        cull_z.push_back(center.z);
+        cull_radius.push_back(radius);
+    }
+
+    cull_visible.resize(cull_indices.size());
+    frustum.testSpheres(cull_x.data(), cull_y.data(), cull_z.data(), cull_radius.data(),
+                        cull_indices.size(), cull_visible.data());
+
+    for (size_t i = 0; i < cull_indices.size(); i++) {
+        if (!cull_visible[i])
+            items[cull_indices[i]].visible = false;
+    }
+
+    cull_stats = CullStats{.visible = 0, .culled = 0};
+    for (const auto& item: items) {
+        if (item.visible)
+            cull_stats.visible++;
+        else
+            cull_stats.culled++;
+    }
+}
@@ -0,0 +1,128 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_RENDER_QUEUE_H
+#define ZPG_RENDER_QUEUE_H
+
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include "glm/vec3.hpp"
+#include "../models/drawable.h"
+#include "../models/animations/animation.h"
+#include "instance_batch.h"
+#include "frustum.h"
+#include "bvh.h"
+
+using RENDER_KEY = uint64_t;
+
+// passes are submitted in this order, skybox goes first with depth test disabled
+enum class RenderPass : uint8_t {
+    SKYBOX = 0,
+    OPAQUE = 1,
+};
+
+enum class RenderItemType : uint8_t {
+    OBJECT,
+    ANIMATION,
+    BATCH,
+    // frame snapshot only, consecutive objects merged into one multi draw (see FrameSnapshot::addIndirect)
+    INDIRECT,
+};
+
+struct RenderItem {
+    RENDER_KEY key = 0;
+    RenderPass pass = RenderPass::OPAQUE;
+    RenderItemType type = RenderItemType::OBJECT;
+
+    // object is set for every type except BATCH, it provides the shader, texture, model and position
+    DrawableObject* object = nullptr;
+    Animation* animation = nullptr;
+    InstanceBatch* batch = nullptr;
+
+    // result of the last culling pass
+    bool visible = true;
+
+    [[nodiscard]] SHADER_ALIAS_DATATYPE getShaderAlias() const;
+    // the object or batch the item was inserted for
+    [[nodiscard]] const void* getOwner() const;
+    [[nodiscard]] char getStencilID() const;
+};
+
+// items drawn and skipped by the last RenderQueue::cull
+struct CullStats {
+    size_t visible = 0;
+    size_t culled = 0;
+};
+
+//
+// Draw list kept ordered by a packed 64-bit key
+// | pass 4b | shader alias 8b | texture 12b | VAO 16b | depth 24b |
+// so that state changes between consecutive draws are minimal.
+//
+// Insertions and removals are collected and applied by the next updateDepth() (or updateState()) in one pass,
+// removed items are dropped while compacting and the sorted insertions are merged in.
+// Only the depth part changes per frame. Since the order barely changes between frames,
+// it is restored by an insertion sort that falls back to a full sort when the scene got shuffled too much
+// (e.g. camera teleport).
+//
+class RenderQueue {
+public:
+    static constexpr int PASS_SHIFT = 60;
+    static constexpr int SHADER_SHIFT = 52;
+    static constexpr int TEXTURE_SHIFT = 40;
+    static constexpr int VAO_SHIFT = 24;
+
+    static constexpr RENDER_KEY PASS_MASK = 0xF;
+    static constexpr RENDER_KEY SHADER_MASK = 0xFF;
+    static constexpr RENDER_KEY TEXTURE_MASK = 0xFFF;
+    static constexpr RENDER_KEY VAO_MASK = 0xFFFF;
+    static constexpr RENDER_KEY DEPTH_MASK = 0xFFFFFF;
+private:
+    std::vector<RenderItem> items;
+    glm::vec3 eye = glm::vec3(0.f);
+
+    // changes since the last update, the removed objects or batches may already be destroyed
+    std::vector<RenderItem> inserted;
+    std::unordered_set<const void*> removed;
+
+    // culling scratch, world space spheres of cullable items as structure of arrays
+    std::vector<size_t> cull_indices;
+    std::vector<float> cull_x, cull_y, cull_z, cull_radius;
+    std::vector<uint8_t> cull_visible;
+    CullStats cull_stats;
+    uint32_t cull_frame = 0;
+private:
+    static RENDER_KEY makeStateKey(const RenderItem& item);
+    [[nodiscard]] RENDER_KEY makeDepthKey(const RenderItem& item) const;
+    void queueInsert(RenderItem item);
+    void queueRemove(const void* owner);
+    void applyChanges();
+public:
+    void insert(DrawableObject* object, RenderPass pass = RenderPass::OPAQUE);
+    void insert(Animation* animation);
+    void insert(InstanceBatch* batch);
+
+    void remove(const DrawableObject* object);
+    void remove(const InstanceBatch* batch);
+    void clear();
+
+    // apply the pending changes, refresh depth keys against the camera position and restore the order
+    void updateDepth(const glm::vec3& camera_position);
+    // apply the pending changes and recompute the state keys,
+    // placeholder models got their VAO and texture flag once loaded
+    void updateState();
+
+    // mark items outside the frustum as invisible, objects in the BVH are resolved by a tree query
+    void cull(const Frustum& frustum, const DynamicBVH& bvh);
+    [[nodiscard]] const CullStats& getCullStats() const { return cull_stats; }
+
+    [[nodiscard]] size_t size() const { return items.size(); }
+    [[nodiscard]] std::vector<RenderItem>::const_iterator begin() const { return items.cbegin(); }
+    [[nodiscard]] std::vector<RenderItem>::const_iterator end() const { return items.cend(); }
+};
+
+
+#endif //ZPG_RENDER_QUEUE_H
@@ -0,0 +1,137 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <vector>
+#include "vertex_arena.h"
+#include "../models/vertex_format.h"
+#include "../util/const.h"
+
+VertexArena::VertexArena(ModelOptions layout) : layout(layout), vertex_size(VertexFormat::getVertexSize(layout)) {
+    glGenVertexArrays(1, &this->vao);
+}
+
+VertexArena::~VertexArena() {
+    glDeleteBuffers(1, &this->ebo);
+    glDeleteBuffers(1, &this->vbo);
+    glDeleteVertexArrays(1, &this->vao);
+}
+
+ArenaRange VertexArena::place(const Model& model) {
+    auto found = ranges.find(&model);
+    if (found != ranges.end())
+        return found->second;
+
+    const GLsizeiptr model_size = static_cast<GLsizeiptr>(model.getVertexCount()) * vertex_size;
+    if (size + model_size > capacity)
+        grow(size + model_size);
+
+    glBindBuffer(GL_COPY_READ_BUFFER, model.getVBO());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->vbo);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, size, model_size);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    ArenaRange range;
+    range.first_vertex = static_cast<GLint>(size / vertex_size);
+    size += model_size;
+    if (model.isIndexed())
+        range.first_index = placeIndices(model);
+    ranges.emplace(&model, range);
+    return range;
+}
+
+GLint VertexArena::placeIndices(const Model& model) {
+    const GLsizeiptr indices_size = model.getIndexCount() * static_cast<GLsizeiptr>(sizeof(GLuint));
+    if (index_size + indices_size > index_capacity)
+        growIndices(index_size + indices_size);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->ebo);
+    glBindBuffer(GL_COPY_READ_BUFFER, model.getEBO());
+    if (model.getIndexType() == GL_UNSIGNED_INT) {
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, index_size, indices_size);
+    } else {
+        // the arena indices are all 32-bit, widen the short ones on the CPU, once per model
+        std::vector<GLushort> short_indices(model.getIndexCount());
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0,
+                           static_cast<GLsizeiptr>(short_indices.size() * sizeof(GLushort)), short_indices.data());
+        std::vector<GLuint> indices(short_indices.begin(), short_indices.end());
+        glBufferSubData(GL_COPY_WRITE_BUFFER, index_size, indices_size, indices.data());
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    auto first_index = static_cast<GLint>(index_size / sizeof(GLuint));
+    index_size += indices_size;
+    return first_index;
+}
+
+void VertexArena::growIndices(GLsizeiptr required) {
+    GLsizeiptr new_capacity = std::max(required, index_capacity * 2);
+
+    GLuint new_ebo;
+    glGenBuffers(1, &new_ebo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, new_ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, new_capacity, nullptr, GL_STATIC_DRAW);
+    if (index_size > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, this->ebo);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, index_size);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &this->ebo);
+    this->ebo = new_ebo;
+    this->index_capacity = new_capacity;
+
+    // the element binding is VAO state, unlike the attribute buffers it can be rebound directly
+    glBindVertexArray(this->vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ebo);
+    glBindVertexArray(0);
+}
+
+void VertexArena::grow(GLsizeiptr required) {
+    // models arrive one by one, double to keep the copies amortized
+    GLsizeiptr new_capacity = std::max(required, capacity * 2);
+
+    GLuint new_vbo;
+    glGenBuffers(1, &new_vbo);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, new_vbo);
+    glBufferData(GL_COPY_WRITE_BUFFER, new_capacity, nullptr, GL_STATIC_DRAW);
+    if (size > 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, this->vbo);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &this->vbo);
+    this->vbo = new_vbo;
+    this->capacity = new_capacity;
+    setVertexAttributes();
+}
+
+void VertexArena::setVertexAttributes() const {
+    glBindVertexArray(this->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
+    // same locations and formats as the per-model VAOs
+    VertexFormat::setAttributes(layout);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void VertexArena::setDrawIDs(GLuint buffer) const {
+    glBindVertexArray(this->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glEnableVertexAttribArray(DRAW_ID_ATTRIBUTE);
+    glVertexAttribIPointer(DRAW_ID_ATTRIBUTE, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*) 0);
+    // advances per instance, which starts at the base instance of the command
+    glVertexAttribDivisor(DRAW_ID_ATTRIBUTE, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void VertexArena::bind() const {
+    glBindVertexArray(this->vao);
+}
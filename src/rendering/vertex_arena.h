@@ -0,0 +1,70 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_VERTEX_ARENA_H
+#define ZPG_VERTEX_ARENA_H
+
+//Include GLEW
+#include <GL/glew.h>
+
+#include <unordered_map>
+#include "../models/model.h"
+
+// where a model landed inside an arena
+struct ArenaRange {
+    GLint first_vertex = 0;
+    // -1 for unindexed models
+    GLint first_index = -1;
+};
+
+//
+// One vertex buffer and VAO shared by every model with the same vertex layout (Model::getVertexLayout),
+// so that draws of different models can be merged into a single multi draw.
+// Models are copied in on their first use, buffer to buffer without a round trip through the CPU,
+// and keep their own VAO for the regular draw path.
+// Indexed models get their indices appended to a shared element buffer, always 32-bit,
+// and are drawn with the base vertex of their range.
+// The VAO also carries the per-draw index attribute (DRAW_ID_ATTRIBUTE, divisor 1),
+// indirect commands select it with their base instance.
+//
+class VertexArena {
+private:
+    // vertex layout of every model in the arena, see VertexFormat
+    ModelOptions layout;
+    GLsizei vertex_size; // bytes
+
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLsizeiptr capacity = 0; // bytes
+    GLsizeiptr size = 0; // bytes
+
+    GLuint ebo = 0;
+    GLsizeiptr index_capacity = 0; // bytes
+    GLsizeiptr index_size = 0; // bytes
+
+    // ranges of every model already in the arena
+    std::unordered_map<const Model*, ArenaRange> ranges;
+private:
+    void grow(GLsizeiptr required);
+    void growIndices(GLsizeiptr required);
+    GLint placeIndices(const Model& model);
+    void setVertexAttributes() const;
+public:
+    explicit VertexArena(ModelOptions layout);
+    ~VertexArena();
+
+    VertexArena(const VertexArena&) = delete;
+    VertexArena& operator=(const VertexArena&) = delete;
+
+    // range of the model inside the arena, copies it in on first use
+    ArenaRange place(const Model& model);
+    // point the draw index attribute of the VAO to a buffer of consecutive GLuint indices
+    void setDrawIDs(GLuint buffer) const;
+    void bind() const;
+
+    [[nodiscard]] ModelOptions getLayout() const { return layout; }
+};
+
+
+#endif //ZPG_VERTEX_ARENA_H
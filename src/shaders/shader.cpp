@@ -7,7 +7,11 @@
 //Include GLFW
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
 #include <utility>
+#include <vector>
 #include <stdexcept>
 
 //Include GLM
@@ -18,18 +22,42 @@
 #include "glm/gtc/type_ptr.hpp" // glm::value_ptr
 
 #include "shader.h"
+#include "../util/profiler.h"
+#include "../util/render_stats.h"
 #include "../rendering/light/point_light.h"
 
+namespace {
+    // which input an active uniform belongs to, names as declared in the shader sources
+    SHADER_REQUIREMENTS uniformRequirement(std::string_view uniform_name) {
+        if (uniform_name == "model_matrix")
+            return REQUIRES_MODEL_MATRIX;
+        if (uniform_name == "normal_matrix")
+            return REQUIRES_NORMAL_MATRIX;
+        if (uniform_name.substr(0, 9) == "material.")
+            return REQUIRES_MATERIAL;
+        if (uniform_name == "texture_sampler")
+            return REQUIRES_TEXTURE;
+        if (uniform_name == "instance_sampler")
+            return REQUIRES_INSTANCES;
+        if (uniform_name == "light_sampler" || uniform_name == "cluster_sampler"
+            || uniform_name == "light_index_sampler")
+            return REQUIRES_LIGHTS;
+        return REQUIRES_NOTHING;
+    }
+}
+
 
 void Shader::load() {
     if (active) return;
     glUseProgram(shader_program);
+    RenderStats::counters().program_switches++;
     active = true;
 }
 
 void Shader::unload() {
     if (!active) return;
     glUseProgram(0);
+    RenderStats::counters().program_switches++;
     active = false;
 }
 
@@ -117,62 +145,123 @@ void Shader::update(const EventArgs& event_args) {
     }
 }
 
+// every call pays a glGetUniformLocation on top of the upload
+void Shader::countUniformByName() {
+    auto& stats = RenderStats::counters();
+    stats.uniform_lookups++;
+    stats.uniform_uploads++;
+}
+
 // TODO: rework to work with uniforms.h
 void Shader::passUniform1i(const std::string& uniform_name, int value) const {
+    countUniformByName();
     glUniform1i(glGetUniformLocation(shader_program, uniform_name.c_str()), value);
 }
 
 void Shader::passUniform1f(const std::string& uniform_name, float value) const {
+    countUniformByName();
     glUniform1f(glGetUniformLocation(shader_program, uniform_name.c_str()), value);
 }
 
 void Shader::passUniform3fv(const std::string& uniform_name, const glm::vec3& value) const {
+    countUniformByName();
     glUniform3fv(glGetUniformLocation(shader_program, uniform_name.c_str()),
                  1, glm::value_ptr(value));
 }
 
 void Shader::passUniform4fv(const std::string& uniform_name, const glm::vec4& value) const {
+    countUniformByName();
     glUniform4fv(glGetUniformLocation(shader_program, uniform_name.c_str()),
                  1, glm::value_ptr(value));
 }
 
 void Shader::passUniformMatrix3fv(const std::string& uniform_name, const glm::mat3& value) const {
+    countUniformByName();
     glUniformMatrix3fv(glGetUniformLocation(shader_program, uniform_name.c_str()),
                        1, GL_FALSE, glm::value_ptr(value));
 }
 
 void Shader::passUniformMatrix4fv(const std::string& uniform_name, const glm::mat4& value) const {
+    countUniformByName();
     glUniformMatrix4fv(glGetUniformLocation(shader_program, uniform_name.c_str()),
                        1, GL_FALSE, glm::value_ptr(value));
 }
 
 void Shader::lazyPassUniforms() {
+    ZPG_PROFILE_SCOPE("Shader::lazyPassUniforms");
     uniforms.lazyPassUniforms();
     dynamic_uniforms.lazyPassUniforms();
 }
 
 void Shader::initUniforms() {
+    initRequirements();
+
     uniforms.model.location = glGetUniformLocation(shader_program, "model_matrix");
-    uniforms.view.location = glGetUniformLocation(shader_program, "view_matrix");
-    uniforms.projection.location = glGetUniformLocation(shader_program, "projection_matrix");
     uniforms.normal.location = glGetUniformLocation(shader_program, "normal_matrix");
-    uniforms.camera_position.location = glGetUniformLocation(shader_program, "camera_position");
     uniforms.texture_unit.location = glGetUniformLocation(shader_program, "texture_sampler");
+    uniforms.instance_unit.location = glGetUniformLocation(shader_program, "instance_sampler");
 
-    initLightUniforms();
+    initUniformBlocks();
+    if (uses(REQUIRES_LIGHTS))
+        initLightSamplers();
     initMaterialUniforms();
 }
 
-void Shader::initLightUniforms() {
-    initLightUniform(dynamic_uniforms.point_loc, dynamic_uniforms.point_num_loc,
-                     POINT_CONFIG.collection_name, POINT_CONFIG.count_name,
-                     POINT_CONFIG.max_count, PointLight::getParameterNames().begin(), POINT_CONFIG.parameter_count);
-    initLightUniform(dynamic_uniforms.directional_loc, dynamic_uniforms.directional_num_loc,
-                        DIRECTIONAL_CONFIG.collection_name, DIRECTIONAL_CONFIG.count_name,
-                        DIRECTIONAL_CONFIG.max_count, DirectionalLight::getParameterNames().begin(), DIRECTIONAL_CONFIG.parameter_count);
-    initLightUniform(dynamic_uniforms.spotlight_loc, dynamic_uniforms.spotlight_num_loc,
-                        SPOTLIGHT_CONFIG.collection_name, SPOTLIGHT_CONFIG.count_name,
-                        SPOTLIGHT_CONFIG.max_count, Spotlight::getParameterNames().begin(), SPOTLIGHT_CONFIG.parameter_count);
+void Shader::initRequirements() {
+    requirements = REQUIRES_NOTHING;
+
+    // unused uniforms are optimized out by the linker, only the active ones count
+    GLint uniform_count = 0;
+    GLint uniform_name_length = 0;
+    glGetProgramiv(shader_program, GL_ACTIVE_UNIFORMS, &uniform_count);
+    glGetProgramiv(shader_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &uniform_name_length);
+    std::vector<GLchar> uniform_name(std::max(uniform_name_length, 1), '\0');
+    for (GLint i = 0; i < uniform_count; i++) {
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(shader_program, i, static_cast<GLsizei>(uniform_name.size()), nullptr,
+                           &size, &type, uniform_name.data());
+        requirements |= uniformRequirement(uniform_name.data());
+    }
+
+    GLint block_count = 0;
+    GLint block_name_length = 0;
+    glGetProgramiv(shader_program, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+    glGetProgramiv(shader_program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &block_name_length);
+    std::vector<GLchar> block_name(std::max(block_name_length, 1), '\0');
+    for (GLint i = 0; i < block_count; i++) {
+        glGetActiveUniformBlockName(shader_program, i, static_cast<GLsizei>(block_name.size()), nullptr,
+                                    block_name.data());
+        if (strcmp(block_name.data(), CAMERA_BLOCK_NAME) == 0)
+            requirements |= REQUIRES_CAMERA_BLOCK;
+        else if (strcmp(block_name.data(), LIGHTS_BLOCK_NAME) == 0)
+            requirements |= REQUIRES_LIGHTS;
+    }
+}
+
+void Shader::initLightSamplers() {
+    // clustered lighting units are fixed, set them once instead of passing them with every draw
+    glUseProgram(shader_program);
+    Uniforms::passUniform1i(glGetUniformLocation(shader_program, "light_sampler"), LIGHT_DATA_TEXTURE_UNIT);
+    Uniforms::passUniform1i(glGetUniformLocation(shader_program, "cluster_sampler"), CLUSTER_TEXTURE_UNIT);
+    Uniforms::passUniform1i(glGetUniformLocation(shader_program, "light_index_sampler"), LIGHT_INDEX_TEXTURE_UNIT);
+    glUseProgram(0);
+}
+
+void Shader::initUniformBlocks() {
+    if (uses(REQUIRES_CAMERA_BLOCK))
+        initUniformBlock(CAMERA_BLOCK_NAME, CAMERA_BLOCK_BINDING);
+    if (uses(REQUIRES_LIGHTS))
+        initUniformBlock(LIGHTS_BLOCK_NAME, LIGHTS_BLOCK_BINDING);
+}
+
+void Shader::initUniformBlock(const char* block_name, GLuint binding) {
+    GLuint block_index = glGetUniformBlockIndex(shader_program, block_name);
+    if (block_index == GL_INVALID_INDEX) {
+        printf("Uniform block %s not found in %s shader - skipping.\n", block_name, name.c_str());
+        return;
+    }
+    glUniformBlockBinding(shader_program, block_index, binding);
 }
 
 void Shader::initMaterialUniforms() {
@@ -181,26 +270,3 @@ void Shader::initMaterialUniforms() {
     dynamic_uniforms.material_loc[2] = glGetUniformLocation(shader_program, "material.specular");
     dynamic_uniforms.material_loc[3] = glGetUniformLocation(shader_program, "material.shininess");
 }
-
-template <std::size_t SIZE>
-void Shader::initLightUniform(std::array<int, SIZE>& uniform_locations, SHADER_UNIFORM_LOCATION& num_uniform_location,
-                              const char* collection_name, const char* count_name,
-                              int max_light_count, const char** param_names, int light_param_count) {
-    num_uniform_location = glGetUniformLocation(shader_program, count_name);
-    if (num_uniform_location == -1) {
-        printf("Uniform %s not found in %s shader - skipping light init.\n", count_name, name.c_str());
-        return;
-    }
-
-    for (int i = 0; i < max_light_count; i++) {
-        for (int j = 0; j < light_param_count; j++) {
-            std::string varname_element_name =
-                    std::string(collection_name) + "[" + std::to_string(i) + "]." + param_names[j];
-            GLint loc = glGetUniformLocation(shader_program, varname_element_name.c_str());
-            if (loc == -1)
-                throw std::runtime_error("Uniform " + varname_element_name + " not found in " + name + " shader.");
-            uniform_locations[i*light_param_count + j] = loc;
-        }
-    }
-
-}
\ No newline at end of file
@@ -22,7 +22,6 @@
 #include "../util/const.h"
 
 #include "uniforms/shader_uniforms.h"
-#include "../rendering/light/light.h"
 #include "uniforms/dynamic_uniforms.h"
 
 enum class ShaderType {
@@ -46,16 +45,18 @@ private:
     GLuint vertex_shader = 0;
     GLuint fragment_shader = 0;
 
+    SHADER_REQUIREMENTS requirements = REQUIRES_NOTHING;
     ShaderUniforms uniforms;
     DynamicUniforms dynamic_uniforms;
 private:
     void attachShader(const ShaderCode& shader_code);
 
-    void initLightUniforms();
-    template <std::size_t SIZE>
-    void initLightUniform(std::array<int, SIZE>& uniform_locations, SHADER_UNIFORM_LOCATION& num_uniform_location,
-                                  const char* collection_name, const char* count_name,
-                                  int max_light_count, const char** param_names, int light_param_count);
+    // fills requirements from the active uniforms and blocks of the linked program
+    void initRequirements();
+    void initUniformBlocks();
+    void initUniformBlock(const char* block_name, GLuint binding);
+    void initLightSamplers();
+    static void countUniformByName();
     void initMaterialUniforms();
 public:
     Shader(const SHADER_ALIAS_DATATYPE shader_alias, std::string name,
@@ -74,6 +75,11 @@ public:
 
     [[nodiscard]] std::string getName() const { return name; }
 
+    // valid after initUniforms()
+    [[nodiscard]] SHADER_REQUIREMENTS getRequirements() const { return requirements; }
+    // the program reads any of the masked inputs
+    [[nodiscard]] bool uses(SHADER_REQUIREMENTS mask) const { return (requirements & mask) != 0; }
+
     void update(const EventArgs& event_args) override;
 
     void passUniform1i(const std::string& uniform_name, int value) const;
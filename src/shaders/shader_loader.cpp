@@ -14,11 +14,14 @@
 #include "glm/gtc/matrix_transform.hpp" // glm::translate, glm::rotate, glm::scale, glm::perspective
 #include "glm/gtc/type_ptr.hpp" // glm::value_ptr
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
 #include "shader_loader.h"
 #include "../util/const.h"
+#include "../util/profiler.h"
+#include "../rendering/indirect_renderer.h"
 
 
 std::string ShaderLoader::loadShaderFromFile(const std::string& path) {
@@ -29,6 +32,7 @@ std::string ShaderLoader::loadShaderFromFile(const std::string& path) {
 }
 
 void ShaderLoader::loadShaders() {
+    ZPG_PROFILE_SCOPE("ShaderLoader::loadShaders");
     for (const auto& entry: std::filesystem::directory_iterator(SHADERS_PATH)) {
         if (entry.is_directory()) continue;
         std::string path = entry.path().string();
@@ -38,6 +42,13 @@ void ShaderLoader::loadShaders() {
         if (extension != ".vert")
             continue;
 
+        // multi draw variants need OpenGL 4.3, they would not even compile on older contexts
+        const size_t suffix_length = std::strlen(INDIRECT_SHADER_SUFFIX);
+        bool indirect = name.size() > suffix_length
+                        && name.compare(name.size() - suffix_length, suffix_length, INDIRECT_SHADER_SUFFIX) == 0;
+        if (indirect && !IndirectRenderer::isSupported())
+            continue;
+
         std::string fragment_path = path.substr(0, path.size() - 4) + "frag";
 
         if (!std::filesystem::exists(fragment_path)) {
@@ -59,6 +70,11 @@ void ShaderLoader::loadShaders() {
 
         printf("Successfully loaded shader %s(%d)\n", name.c_str(), next_alias);
     }
+
+    indirect_aliases.clear();
+    for (const auto& shader: shaders) {
+        indirect_aliases.push_back(getShaderAlias(shader->getName() + INDIRECT_SHADER_SUFFIX));
+    }
 }
 
 Shader* ShaderLoader::loadShader(const SHADER_ALIAS_DATATYPE& alias) {
@@ -29,12 +29,17 @@ class ShaderLoader {
 private:
     SHADER_ALIAS_DATATYPE active_shader = SHADER_UNLOADED;
     std::vector<std::unique_ptr<Shader>> shaders;
+    // "<name>_indirect" variant of every shader or SHADER_UNLOADED, looked up once per frame and draw
+    std::vector<SHADER_ALIAS_DATATYPE> indirect_aliases;
 
     static std::string loadShaderFromFile(const std::string& path);
 public:
     void loadShaders();
     Shader* loadShader(const SHADER_ALIAS_DATATYPE& alias);
+    // without binding it, for attaching observers
+    [[nodiscard]] Shader* getShader(const SHADER_ALIAS_DATATYPE& alias) const { return shaders[alias].get(); }
     SHADER_ALIAS_DATATYPE getShaderAlias(const std::string& name);
+    [[nodiscard]] SHADER_ALIAS_DATATYPE getIndirectAlias(SHADER_ALIAS_DATATYPE alias) const { return indirect_aliases[alias]; }
 
     bool unloadShader();
 
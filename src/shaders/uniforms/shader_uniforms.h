@@ -21,12 +21,11 @@ public:
     // To ensure stable scene, you have to make sure that the matrices are not deleted (or REALLOCATED!) while the scene is being rendered.
     // Please, for the sake of your sanity, delete your objects out of the render loop if necessary.
     //
+    // view, projection and camera position live in the shared Camera uniform block
     ShaderUniform<const glm::mat4*> model;
-    ShaderUniform<const glm::mat4*> view;
-    ShaderUniform<const glm::mat4*> projection;
     ShaderUniform<const glm::mat3*> normal;
-    ShaderUniform<const glm::vec3*> camera_position;
     ShaderUniform<TEXTURE_UNIT> texture_unit{.value = 0}; // default texture unit is 0
+    ShaderUniform<TEXTURE_UNIT> instance_unit{.value = 0}; // buffer texture with per-instance data
     ShaderUniforms() = default;
 
     void passEvent(const EventArgs& event_args);
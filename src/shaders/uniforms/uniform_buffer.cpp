@@ -0,0 +1,36 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <stdexcept>
+#include "uniform_buffer.h"
+#include "../../util/render_stats.h"
+
+UniformBuffer::UniformBuffer(GLsizeiptr size, GLuint binding) : size(size), binding(binding) {
+    glGenBuffers(1, &this->buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, this->buffer);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    bindBase();
+}
+
+UniformBuffer::~UniformBuffer() {
+    glDeleteBuffers(1, &this->buffer);
+}
+
+void UniformBuffer::bindBase() const {
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, this->buffer);
+}
+
+void UniformBuffer::update(GLintptr offset, GLsizeiptr data_size, const void* data) const {
+    if (offset + data_size > size)
+        throw std::runtime_error("UniformBuffer::update: Write out of buffer bounds");
+
+    glBindBuffer(GL_UNIFORM_BUFFER, this->buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, data_size, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    auto& stats = RenderStats::counters();
+    stats.buffer_uploads++;
+    stats.buffer_upload_bytes += data_size;
+}
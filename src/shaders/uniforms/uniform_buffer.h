@@ -0,0 +1,37 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_UNIFORM_BUFFER_H
+#define ZPG_UNIFORM_BUFFER_H
+
+
+#include <GL/glew.h>
+
+//
+// Uniform buffer object bound to a fixed binding point, shared by every program
+// that binds its uniform block to the same point (see Shader::initUniforms).
+// Data layout is up to the owner, blocks are declared as std140 in the shaders.
+//
+class UniformBuffer {
+private:
+    GLuint buffer = 0;
+    GLsizeiptr size;
+    GLuint binding;
+public:
+    UniformBuffer(GLsizeiptr size, GLuint binding);
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    // attach the buffer to its binding point, needed again when another buffer took the point over
+    void bindBase() const;
+    void update(GLintptr offset, GLsizeiptr data_size, const void* data) const;
+
+    [[nodiscard]] GLsizeiptr getSize() const { return size; }
+    [[nodiscard]] GLuint getBinding() const { return binding; }
+};
+
+
+#endif //ZPG_UNIFORM_BUFFER_H
@@ -0,0 +1,299 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include "transform_store.h"
+#include "glm/ext/matrix_transform.hpp"
+#include "glm/trigonometric.hpp"
+#include "glm/matrix.hpp"
+#include "../util/const.h"
+#include "../util/thread_pool.h"
+
+namespace {
+    // moves the live slots to their new index, dead ones are dropped
+    template<typename T>
+    void permute(std::vector<T>& values, const std::vector<uint32_t>& new_index,
+                 const std::vector<uint8_t>& alive, size_t live) {
+        std::vector<T> moved(live);
+        for (size_t slot = 0; slot < values.size(); slot++) {
+            if (alive[slot])
+                moved[new_index[slot]] = std::move(values[slot]);
+        }
+        values.swap(moved);
+    }
+}
+
+TransformStore& TransformStore::get() {
+    static TransformStore store;
+    return store;
+}
+
+TRANSFORM_ID TransformStore::create(const glm::vec3& translation) {
+    TRANSFORM_ID handle;
+    if (!free_handles.empty()) {
+        handle = free_handles.back();
+        free_handles.pop_back();
+    } else {
+        handle = static_cast<TRANSFORM_ID>(slots.size());
+        slots.push_back(0);
+    }
+
+    // appended as a root, rebuildOrder moves it into the first level
+    slots[handle] = static_cast<uint32_t>(handles.size());
+    translations.push_back(translation);
+    rotations.emplace_back(0.f);
+    scales.emplace_back(1.f);
+    orbit_axes.emplace_back(0.f);
+    orbit_origins.emplace_back(0.f);
+    orbit_angles.push_back(0.f);
+    has_orbit.push_back(0);
+    parents.push_back(-1);
+    dirty.push_back(1);
+    versions.push_back(0);
+    parent_versions.push_back(0);
+    normal_required.push_back(1);
+    world.emplace_back(1.f);
+    normal.emplace_back(1.f);
+    handles.push_back(handle);
+    alive.push_back(1);
+
+    order_dirty = true;
+    modified = true;
+    return handle;
+}
+
+TRANSFORM_ID TransformStore::create(const glm::vec3& translation, const glm::vec3& orbit_axis) {
+    TRANSFORM_ID handle = create(translation);
+    uint32_t slot = slots[handle];
+    orbit_axes[slot] = orbit_axis;
+    has_orbit[slot] = 1;
+    return handle;
+}
+
+void TransformStore::release(TRANSFORM_ID handle) {
+    alive[slots[handle]] = 0;
+    free_handles.push_back(handle);
+    // children of the released slot become roots once the order is rebuilt
+    order_dirty = true;
+}
+
+void TransformStore::setParent(TRANSFORM_ID handle, TRANSFORM_ID parent) {
+    uint32_t slot = slots[handle];
+    parents[slot] = parent == TRANSFORM_NULL ? -1 : static_cast<int32_t>(slots[parent]);
+    dirty[slot] = 1;
+    order_dirty = true;
+    modified = true;
+}
+
+void TransformStore::markDirty(TRANSFORM_ID handle) {
+    dirty[slots[handle]] = 1;
+    modified.store(true, std::memory_order_relaxed);
+}
+
+void TransformStore::setTranslation(TRANSFORM_ID handle, const glm::vec3& translation) {
+    translations[slots[handle]] = translation;
+    markDirty(handle);
+}
+
+void TransformStore::translate(TRANSFORM_ID handle, const glm::vec3& delta) {
+    translations[slots[handle]] += delta;
+    markDirty(handle);
+}
+
+void TransformStore::setRotation(TRANSFORM_ID handle, const glm::vec3& rotation) {
+    rotations[slots[handle]] = rotation;
+    markDirty(handle);
+}
+
+void TransformStore::rotate(TRANSFORM_ID handle, const glm::vec3& delta) {
+    rotations[slots[handle]] += delta;
+    markDirty(handle);
+}
+
+void TransformStore::setScale(TRANSFORM_ID handle, const glm::vec3& scale) {
+    scales[slots[handle]] = scale;
+    markDirty(handle);
+}
+
+void TransformStore::scale(TRANSFORM_ID handle, const glm::vec3& delta) {
+    scales[slots[handle]] += delta;
+    markDirty(handle);
+}
+
+void TransformStore::orbit(TRANSFORM_ID handle, float delta, const glm::vec3& origin) {
+    uint32_t slot = slots[handle];
+    if (!has_orbit[slot])
+        return;
+
+    orbit_origins[slot] = origin;
+    float& angle = orbit_angles[slot];
+    angle += delta;
+    if (angle > 360.0f)
+        angle -= static_cast<float>(static_cast<int>(angle / 360.0f)) * 360.0f;
+    markDirty(handle);
+}
+
+void TransformStore::setNormalRequired(TRANSFORM_ID handle, bool required) {
+    uint8_t& flag = normal_required[slots[handle]];
+    if (flag == static_cast<uint8_t>(required))
+        return;
+    flag = required;
+    // the skipped normal matrix has to catch up
+    if (required)
+        markDirty(handle);
+}
+
+bool TransformStore::isStale(size_t slot) const {
+    int32_t parent = parents[slot];
+    return dirty[slot] || (parent >= 0 && parent_versions[slot] != versions[parent]);
+}
+
+void TransformStore::compute(size_t slot) {
+    int32_t parent = parents[slot];
+    glm::mat4 matrix = parent >= 0 ? world[parent] : glm::mat4(1.0f);
+
+    matrix = glm::translate(matrix, translations[slot]);
+    // a zero angle is an exact identity, most objects never rotate
+    const glm::vec3& rotation = rotations[slot];
+    if (rotation.x != 0.f)
+        matrix = glm::rotate(matrix, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    if (rotation.y != 0.f)
+        matrix = glm::rotate(matrix, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    if (rotation.z != 0.f)
+        matrix = glm::rotate(matrix, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    if (has_orbit[slot] && orbit_angles[slot] != 0.f) {
+        matrix = glm::translate(matrix, orbit_origins[slot]);
+        matrix = glm::rotate(matrix, glm::radians(orbit_angles[slot]), orbit_axes[slot]);
+        matrix = glm::translate(matrix, -orbit_origins[slot]);
+    }
+    matrix = glm::scale(matrix, scales[slot]);
+
+    world[slot] = matrix;
+    if (normal_required[slot])
+        normal[slot] = glm::mat3(glm::transpose(glm::inverse(glm::mat3(matrix))));
+    versions[slot]++;
+    parent_versions[slot] = parent >= 0 ? versions[parent] : 0;
+    dirty[slot] = 0;
+}
+
+void TransformStore::resolve(size_t slot) {
+    if (parents[slot] >= 0)
+        resolve(parents[slot]);
+    if (isStale(slot))
+        compute(slot);
+}
+
+void TransformStore::rebuildOrder() {
+    const size_t count = handles.size();
+
+    // depth of every live slot, parents that were released detach their children
+    std::vector<int32_t> depths(count, -1);
+    std::vector<size_t> chain;
+    for (size_t slot = 0; slot < count; slot++) {
+        if (!alive[slot] || depths[slot] >= 0)
+            continue;
+        size_t current = slot;
+        while (depths[current] < 0) {
+            chain.push_back(current);
+            int32_t parent = parents[current];
+            if (parent >= 0 && !alive[parent]) {
+                parents[current] = -1;
+                dirty[current] = 1;
+                parent = -1;
+            }
+            if (parent < 0) {
+                depths[current] = 0;
+                chain.pop_back();
+                break;
+            }
+            current = parent;
+        }
+        while (!chain.empty()) {
+            depths[chain.back()] = depths[parents[chain.back()]] + 1;
+            chain.pop_back();
+        }
+    }
+
+    // counting sort by depth, stable so unrelated slots keep their relative order
+    level_offsets.assign(1, 0);
+    for (size_t slot = 0; slot < count; slot++) {
+        if (!alive[slot])
+            continue;
+        auto level = static_cast<size_t>(depths[slot]) + 1;
+        if (level_offsets.size() <= level)
+            level_offsets.resize(level + 1, 0);
+        level_offsets[level]++;
+    }
+    for (size_t level = 1; level < level_offsets.size(); level++) {
+        level_offsets[level] += level_offsets[level - 1];
+    }
+    const size_t live = level_offsets.back();
+
+    std::vector<size_t> next(level_offsets.begin(), level_offsets.end() - 1);
+    std::vector<uint32_t> new_index(count, 0);
+    for (size_t slot = 0; slot < count; slot++) {
+        if (alive[slot])
+            new_index[slot] = static_cast<uint32_t>(next[depths[slot]]++);
+    }
+
+    for (size_t slot = 0; slot < count; slot++) {
+        if (alive[slot] && parents[slot] >= 0)
+            parents[slot] = static_cast<int32_t>(new_index[parents[slot]]);
+    }
+    permute(translations, new_index, alive, live);
+    permute(rotations, new_index, alive, live);
+    permute(scales, new_index, alive, live);
+    permute(orbit_axes, new_index, alive, live);
+    permute(orbit_origins, new_index, alive, live);
+    permute(orbit_angles, new_index, alive, live);
+    permute(has_orbit, new_index, alive, live);
+    permute(parents, new_index, alive, live);
+    permute(dirty, new_index, alive, live);
+    permute(versions, new_index, alive, live);
+    permute(parent_versions, new_index, alive, live);
+    permute(normal_required, new_index, alive, live);
+    permute(world, new_index, alive, live);
+    permute(normal, new_index, alive, live);
+    permute(handles, new_index, alive, live);
+    alive.assign(live, 1);
+
+    for (size_t slot = 0; slot < live; slot++) {
+        slots[handles[slot]] = static_cast<uint32_t>(slot);
+    }
+    order_dirty = false;
+}
+
+void TransformStore::update() {
+    if (order_dirty)
+        rebuildOrder();
+    if (!modified)
+        return;
+
+    // a level only reads the finished matrices of the level above
+    ThreadPool& pool = ThreadPool::get();
+    for (size_t level = 0; level + 1 < level_offsets.size(); level++) {
+        const size_t begin = level_offsets[level];
+        pool.parallelFor(level_offsets[level + 1] - begin, TRANSFORM_UPDATE_GRAIN,
+                         [this, begin](size_t first, size_t last) {
+                             for (size_t slot = begin + first; slot < begin + last; slot++) {
+                                 if (isStale(slot))
+                                     compute(slot);
+                             }
+                         });
+    }
+    modified = false;
+}
+
+const glm::mat4& TransformStore::getWorld(TRANSFORM_ID handle) {
+    uint32_t slot = slots[handle];
+    if (modified)
+        resolve(slot);
+    return world[slot];
+}
+
+const glm::mat3& TransformStore::getNormal(TRANSFORM_ID handle) {
+    uint32_t slot = slots[handle];
+    if (modified)
+        resolve(slot);
+    return normal[slot];
+}
@@ -0,0 +1,108 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_TRANSFORM_STORE_H
+#define ZPG_TRANSFORM_STORE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "glm/vec3.hpp"
+#include "glm/mat3x3.hpp"
+#include "glm/mat4x4.hpp"
+
+using TRANSFORM_ID = uint32_t;
+inline constexpr TRANSFORM_ID TRANSFORM_NULL = UINT32_MAX;
+
+//
+// Local and world transforms of every DrawableObject in flat arrays, one slot per transform.
+// The world matrix is M = M_parent × T × R_x × R_y × R_z × R_orbit × S, where R_orbit rotates around
+// orbit_origin and is only used by transforms created with an orbit axis (CentricModelComponent).
+//
+// Slots are kept sorted by depth, a parent always precedes its children and every depth is a contiguous range,
+// so update() recomputes everything that changed in one forward pass per level without any pointer chasing.
+// Setters only mark the slot, getWorld() between two updates resolves the slot and its ancestors on demand.
+// Every recomputation bumps the version of the slot, a child is stale while it has seen an older parent version.
+//
+// Handles stay valid for the whole life of the transform, slots move when the order is rebuilt.
+// Setters may run concurrently on different handles (AnimationManager steps), create, release, setParent,
+// update and getWorld may not.
+//
+class TransformStore {
+private:
+    // local transform data
+    std::vector<glm::vec3> translations;
+    std::vector<glm::vec3> rotations;
+    std::vector<glm::vec3> scales;
+    std::vector<glm::vec3> orbit_axes;
+    std::vector<glm::vec3> orbit_origins;
+    std::vector<float> orbit_angles;
+    std::vector<uint8_t> has_orbit;
+    // slot of the parent or -1
+    std::vector<int32_t> parents;
+
+    // bytes, not vector<bool>, concurrent setters on neighbouring slots must not share a word
+    std::vector<uint8_t> dirty;
+    std::vector<uint32_t> versions;
+    std::vector<uint32_t> parent_versions;
+    // normal matrices no shader reads are not computed
+    std::vector<uint8_t> normal_required;
+
+    // output
+    std::vector<glm::mat4> world;
+    std::vector<glm::mat3> normal;
+
+    // handle <-> slot, released slots are dropped when the order is rebuilt
+    std::vector<uint32_t> slots;
+    std::vector<TRANSFORM_ID> handles;
+    std::vector<TRANSFORM_ID> free_handles;
+    std::vector<uint8_t> alive;
+    // first slot of every depth, plus the end
+    std::vector<size_t> level_offsets;
+
+    bool order_dirty = false;
+    // any setter ran since the last update
+    std::atomic<bool> modified{false};
+private:
+    void markDirty(TRANSFORM_ID handle);
+    [[nodiscard]] bool isStale(size_t slot) const;
+    void compute(size_t slot);
+    void resolve(size_t slot);
+    // drops released slots and sorts the rest by depth
+    void rebuildOrder();
+public:
+    static TransformStore& get();
+
+    TRANSFORM_ID create(const glm::vec3& translation);
+    // with an orbit rotation component around the given axis
+    TRANSFORM_ID create(const glm::vec3& translation, const glm::vec3& orbit_axis);
+    void release(TRANSFORM_ID handle);
+
+    // children follow the world matrix of their parent, TRANSFORM_NULL detaches
+    void setParent(TRANSFORM_ID handle, TRANSFORM_ID parent);
+
+    void setTranslation(TRANSFORM_ID handle, const glm::vec3& translation);
+    void translate(TRANSFORM_ID handle, const glm::vec3& delta);
+    // euler angles in degrees
+    void setRotation(TRANSFORM_ID handle, const glm::vec3& rotation);
+    void rotate(TRANSFORM_ID handle, const glm::vec3& delta);
+    void setScale(TRANSFORM_ID handle, const glm::vec3& scale);
+    void scale(TRANSFORM_ID handle, const glm::vec3& delta);
+    // angle in degrees, no-op without an orbit component
+    void orbit(TRANSFORM_ID handle, float delta, const glm::vec3& origin);
+    // on by default, getNormal returns a stale matrix for slots that turned it off
+    void setNormalRequired(TRANSFORM_ID handle, bool required);
+
+    // recomputes every stale world and normal matrix, level by level on the thread pool
+    void update();
+
+    // references stay valid until the next create, release or update
+    [[nodiscard]] const glm::mat4& getWorld(TRANSFORM_ID handle);
+    [[nodiscard]] const glm::mat3& getNormal(TRANSFORM_ID handle);
+
+    [[nodiscard]] size_t size() const { return handles.size(); }
+};
+
+
+#endif //ZPG_TRANSFORM_STORE_H
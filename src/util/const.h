@@ -5,6 +5,8 @@
 #ifndef ZPG_CONST_H
 #define ZPG_CONST_H
 
+#include <cstddef>
+#include <cstdint>
 #include <GL/glew.h>
 #include "glm/vec3.hpp"
 #include "glm/trigonometric.hpp"
@@ -20,8 +22,73 @@ inline constexpr bool ENABLE_CULL_FACE = true;
 
 inline constexpr bool DISABLE_VSYNC = false;
 
+// Unindexed models get their identical vertices merged at load and are drawn through an element buffer
+inline constexpr bool ENABLE_VERTEX_WELDING = true;
+// The model loaders reorder triangle lists for the post-transform vertex cache and vertex fetch (see MeshOptimizer),
+// VERTEX_CACHE_SIZE is the cache the reordering and the ACMR/ATVR statistics assume
+inline constexpr bool ENABLE_MESH_OPTIMIZATION = true;
+inline constexpr bool ENABLE_OVERDRAW_OPTIMIZATION = true;
+inline constexpr size_t VERTEX_CACHE_SIZE = 32;
+// Loaded models store half float positions, packed normals and 16-bit UVs, see VertexFormat::compress
+inline constexpr bool ENABLE_VERTEX_COMPRESSION = true;
+
+// Static objects whose shader has an "<name>_instanced" variant are drawn in instanced batches
+inline constexpr bool ENABLE_INSTANCING = true;
+const char* const INSTANCED_SHADER_SUFFIX = "_instanced";
+// Texture unit reserved for per-instance data buffer textures
+inline constexpr TEXTURE_UNIT INSTANCE_TEXTURE_UNIT = 1;
+
+// Remaining objects whose shader has an "<name>_indirect" variant are merged into glMultiDrawArraysIndirect calls,
+// needs OpenGL 4.3, older contexts keep drawing them one by one
+inline constexpr bool ENABLE_MULTI_DRAW_INDIRECT = true;
+const char* const INDIRECT_SHADER_SUFFIX = "_indirect";
+// Storage buffer with the per-draw data and the vertex attribute holding the draw index, see the *_indirect.vert shaders
+inline constexpr GLuint DRAW_DATA_STORAGE_BINDING = 0;
+inline constexpr GLuint DRAW_ID_ATTRIBUTE = 3;
+// Texture units reserved for clustered lighting buffer textures (point/spot records, cluster grid, light indices)
+inline constexpr TEXTURE_UNIT LIGHT_DATA_TEXTURE_UNIT = 2;
+inline constexpr TEXTURE_UNIT CLUSTER_TEXTURE_UNIT = 3;
+inline constexpr TEXTURE_UNIT LIGHT_INDEX_TEXTURE_UNIT = 4;
+
 inline constexpr SHADER_ALIAS_DATATYPE SHADER_UNLOADED = (-1);
 
+// Inputs a linked program reads, introspected from its active uniforms and blocks (see Shader::initRequirements)
+using SHADER_REQUIREMENTS = uint32_t;
+enum SHADER_REQUIREMENT : SHADER_REQUIREMENTS {
+    REQUIRES_NOTHING = 0,
+    REQUIRES_MODEL_MATRIX = 1 << 0,
+    REQUIRES_NORMAL_MATRIX = 1 << 1,
+    REQUIRES_MATERIAL = 1 << 2,
+    REQUIRES_TEXTURE = 1 << 3,
+    REQUIRES_INSTANCES = 1 << 4,
+    REQUIRES_CAMERA_BLOCK = 1 << 5,
+    // Lights block and the clustered lighting samplers
+    REQUIRES_LIGHTS = 1 << 6,
+};
+
+using BVH_NODE_ID = int;
+inline constexpr BVH_NODE_ID BVH_NULL_NODE = (-1);
+
+// Froxel grid for clustered lighting, keep in sync with CLUSTER_* in the lit fragment shaders
+inline constexpr int CLUSTER_GRID_X = 16;
+inline constexpr int CLUSTER_GRID_Y = 9;
+inline constexpr int CLUSTER_GRID_Z = 24;
+// Light contribution (intensity * color * attenuation) below which a point or spotlight is ignored
+inline constexpr float LIGHT_INFLUENCE_THRESHOLD = 0.01f;
+
+// Average element moves per item the render queue insertion sort may take before falling back to std::sort
+inline constexpr size_t RENDER_QUEUE_SORT_BUDGET = 8;
+
+// Workers of the shared thread pool, -1 takes one per core besides the simulation thread
+inline constexpr int THREAD_POOL_WORKERS = -1;
+// Animation nodes stepped per thread pool task, smaller levels are stepped on the calling thread
+inline constexpr size_t ANIMATION_STEP_GRAIN = 256;
+// Transform store slots recomputed per thread pool task
+inline constexpr size_t TRANSFORM_UPDATE_GRAIN = 1024;
+
+// Chrome trace files written by the profiler (F3), see profiler.h
+const char* const PROFILER_TRACE_PREFIX = "zpg_trace_";
+
 const char* const SHADERS_PATH = "shaders/";
 const char* const ASSETS_PATH = "assets/";
 
@@ -31,6 +98,33 @@ inline constexpr glm::vec3 AMBIENT_LIGHT = glm::vec3(0.05f, 0.05f, 0.05f);
 
 inline constexpr float FRAME_TIME_MULTIPLIER = 300.f;
 
+// Headless mode (--headless) renders a fixed number of frames with a constant time step
+inline constexpr float HEADLESS_FRAME_TIME = 1.f / 60.f;
+inline constexpr int HEADLESS_DEFAULT_FRAMES = 60;
+
+// Input recordings (--record, --replay), see input_recorder.h
+inline constexpr char INPUT_RECORDING_MAGIC[4] = {'Z', 'P', 'G', 'I'};
+inline constexpr uint32_t INPUT_RECORDING_VERSION = 1;
+
+// Converted meshes (tools/zpg_meshc.cpp), see mesh_file.h
+inline constexpr char MESH_FILE_MAGIC[4] = {'Z', 'P', 'G', 'M'};
+inline constexpr uint32_t MESH_FILE_VERSION = 1;
+// The build writes them into its own tree and passes the directory as ZPG_MESHES_PATH
+#ifdef ZPG_MESHES_PATH
+const char* const MESHES_PATH = ZPG_MESHES_PATH;
+#else
+const char* const MESHES_PATH = "assets/meshes/";
+#endif
+const char* const MESH_FILE_EXTENSION = ".zmesh";
+
+// Background asset loading of windowed scenes, see async_loader.h
+// Workers reading, importing and decoding assets
+inline constexpr int ASYNC_LOADER_WORKERS = 2;
+// GL upload time spent per frame on finished assets, at least one asset is uploaded every frame
+inline constexpr double ASYNC_UPLOAD_BUDGET_MS = 2.0;
+// RGBA texel of textures (and every cube map face) that are still loading
+inline constexpr unsigned char PLACEHOLDER_TEXEL[4] = {128, 128, 128, 255};
+
 // Mouse sensitivity for camera movement
 inline constexpr float MOVEMENT_SENSITIVITY = 0.5f;
 inline constexpr float MOUSE_SENSITIVITY = 0.5f;
@@ -57,6 +151,12 @@ inline constexpr float CAMERA_YAW = -90.0f;
 // Initial camera pitch
 inline constexpr float CAMERA_PITCH = 0.0f;
 
+// Uniform block binding points shared by all programs
+inline constexpr GLuint CAMERA_BLOCK_BINDING = 0;
+const char* const CAMERA_BLOCK_NAME = "Camera";
+inline constexpr GLuint LIGHTS_BLOCK_BINDING = 1;
+const char* const LIGHTS_BLOCK_NAME = "Lights";
+
 // Projection FOV (field of view)
 inline constexpr float PROJECTION_FOV = glm::radians(45.0f);
 // Projection near clipping distance
@@ -20,31 +20,14 @@ inline static Spotlight FLASHLIGHT(glm::vec3(0.0),
         std::cos(glm::radians(17.5f)));
 
 struct LightConfig {
-    const char* collection_name;
-    const char* count_name;
-    const size_t parameter_count;
+    const char* name;
     const size_t max_count;
 };
 
-inline constexpr static const LightConfig POINT_CONFIG = {
-        .collection_name = "point_lights",
-        .count_name = "point_lights_count",
-        .parameter_count = sizeof(PointLight::getParameterNames()) / sizeof(char*),
-        .max_count = 10
-};
-
+// array size of the Lights uniform block, keep in sync with D_MAX_LIGHTS in the fragment shaders
+// point and spotlights are clustered and have no fixed limit
 inline constexpr static const LightConfig DIRECTIONAL_CONFIG = {
-        .collection_name = "directional_lights",
-        .count_name = "directional_lights_count",
-        .parameter_count = sizeof(DirectionalLight::getParameterNames()) / sizeof(char*),
-        .max_count = 5
-};
-
-
-inline constexpr static const LightConfig SPOTLIGHT_CONFIG = {
-        .collection_name = "spotlights",
-        .count_name = "spotlights_count",
-        .parameter_count = sizeof(Spotlight::getParameterNames()) / sizeof(char*),
+        .name = "directional lights",
         .max_count = 5
 };
 
@@ -26,17 +26,13 @@ enum class EventType {
     S_SCALE,
 
     U_MODEL_MATRIX,
-    U_VIEW_MATRIX,
-    U_PROJECTION_MATRIX,
     U_NORMAL_MATRIX,
 
-    U_CAMERA_POSITION,
-
     U_MATERIAL,
     U_TEXTURE_UNIT,
+    U_INSTANCE_UNIT,
 
     U_LIGHT_SINGLE,
-    U_LIGHTS,
 
     //
     // general uniforms
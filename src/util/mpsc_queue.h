@@ -0,0 +1,67 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_MPSC_QUEUE_H
+#define ZPG_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+//
+// Unbounded lock-free queue of many producers and a single consumer (Vyukov's node based queue).
+// Producers swap themselves in as the head and link the previous head to them, a single atomic exchange each.
+// The consumer follows the links from a stub node it owns. A producer caught between the exchange and the link
+// makes its item (and the ones behind it) invisible until it finishes, pop() reports the queue empty meanwhile.
+//
+template<typename T>
+class MpscQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    // producers side
+    std::atomic<Node*> head;
+    // consumer side, its value was already popped
+    Node* tail;
+public:
+    MpscQueue() {
+        Node* stub = new Node();
+        head.store(stub, std::memory_order_relaxed);
+        tail = stub;
+    }
+
+    ~MpscQueue() {
+        T value;
+        while (pop(value)) { }
+        delete tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // any thread
+    void push(T value) {
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // consumer thread only
+    bool pop(T& value) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+            return false;
+        // the popped node becomes the new stub
+        value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
+
+
+#endif //ZPG_MPSC_QUEUE_H
@@ -0,0 +1,147 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include "profiler.h"
+
+#ifdef ZPG_ENABLE_PROFILER
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include "const.h"
+
+void ProfileRing::leave(const ProfileZone& zone) {
+    depth--;
+    uint64_t index = head.load(std::memory_order_relaxed);
+    Slot& slot = zones[index % CAPACITY];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    // the odd sequence has to be visible before any of the fields change
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(zone.name, std::memory_order_relaxed);
+    slot.start_ns.store(zone.start_ns, std::memory_order_relaxed);
+    slot.end_ns.store(zone.end_ns, std::memory_order_relaxed);
+    slot.depth.store(zone.depth, std::memory_order_relaxed);
+    // publish the slot for collect()
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    head.store(index + 1, std::memory_order_release);
+}
+
+void ProfileRing::collect(int64_t since_ns, std::vector<ProfileZone>& out) const {
+    uint64_t end = head.load(std::memory_order_acquire);
+    uint64_t begin = end > CAPACITY ? end - CAPACITY : 0;
+    for (uint64_t i = begin; i < end; ++i) {
+        const Slot& slot = zones[i % CAPACITY];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * i + 2)
+            continue;
+
+        ProfileZone zone{slot.name.load(std::memory_order_relaxed),
+                         slot.start_ns.load(std::memory_order_relaxed),
+                         slot.end_ns.load(std::memory_order_relaxed),
+                         slot.depth.load(std::memory_order_relaxed)};
+        // the owner started overwriting the slot during the copy
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+            continue;
+
+        if (zone.start_ns >= since_ns)
+            out.push_back(zone);
+    }
+}
+
+Profiler& Profiler::get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+int64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ProfileRing* Profiler::localRing() {
+    thread_local ProfileRing* ring = registerThread();
+    return ring;
+}
+
+ProfileRing* Profiler::registerThread() {
+    // once per thread, rings outlive their threads so their zones still get exported
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    rings.push_back(std::make_unique<ProfileRing>(static_cast<uint32_t>(rings.size())));
+    return rings.back().get();
+}
+
+void Profiler::startCapture() {
+    capture_start_ns = now();
+    capturing.store(true, std::memory_order_relaxed);
+    printf("Profiler: capture started\n");
+}
+
+bool Profiler::stopCapture(const std::string& path) {
+    capturing.store(false, std::memory_order_relaxed);
+    return writeChromeTrace(path);
+}
+
+void Profiler::toggleCapture() {
+    if (!isCapturing()) {
+        startCapture();
+        return;
+    }
+
+    std::string path = std::string(PROFILER_TRACE_PREFIX) + std::to_string(std::time(nullptr)) + ".json";
+    if (stopCapture(path))
+        printf("Profiler: trace written to %s\n", path.c_str());
+}
+
+static void writeEscaped(FILE* file, const char* text) {
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\')
+            fputc('\\', file);
+        fputc(*c, file);
+    }
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        printf("Profiler: could not open %s for writing\n", path.c_str());
+        return false;
+    }
+
+    std::vector<ProfileZone> zones;
+    std::lock_guard<std::mutex> lock(rings_mutex);
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    for (const auto& ring: rings) {
+        zones.clear();
+        ring->collect(capture_start_ns, zones);
+
+        uint32_t tid = ring->getThreadIndex();
+        fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                      "\"args\":{\"name\":\"thread %u\"}}",
+                first ? "" : ",", tid, tid);
+        first = false;
+
+        // complete events ("X"), timestamps in microseconds relative to the capture start
+        for (const auto& zone: zones) {
+            fprintf(file, ",\n{\"name\":\"");
+            writeEscaped(file, zone.name);
+            fprintf(file, "\",\"cat\":\"zpg\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                          "\"args\":{\"depth\":%u}}",
+                    tid,
+                    static_cast<double>(zone.start_ns - capture_start_ns) / 1000.0,
+                    static_cast<double>(zone.end_ns - zone.start_ns) / 1000.0,
+                    zone.depth);
+        }
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+#endif //ZPG_ENABLE_PROFILER
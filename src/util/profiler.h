@@ -0,0 +1,132 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_PROFILER_H
+#define ZPG_PROFILER_H
+
+//
+// Scoped CPU profiling zones, compiled in only with the ZPG_ENABLE_PROFILER CMake option.
+// Without it ZPG_PROFILE_SCOPE expands to nothing and none of the code below exists.
+//
+//   ZPG_PROFILE_SCOPE("Scene::cull");
+//
+// Zones are recorded only while a capture is running (F3), each thread writes into its own
+// ring buffer without locking. Stopping the capture exports the zones as a Chrome trace
+// (chrome://tracing, ui.perfetto.dev).
+//
+
+#ifdef ZPG_ENABLE_PROFILER
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ProfileZone {
+    // string literal, only the pointer is stored
+    const char* name;
+    int64_t start_ns;
+    int64_t end_ns;
+    uint32_t depth;
+};
+
+//
+// Single producer ring, only the owning thread writes. Oldest zones are overwritten when full.
+// Every slot is a seqlock: the sequence is odd while the owner writes zone n into it and 2n + 2 once it is done,
+// collect() keeps a copy only if the sequence was 2n + 2 before and after it, so torn or lapped slots are dropped.
+//
+class ProfileRing {
+public:
+    static constexpr size_t CAPACITY = 1 << 16;
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<int64_t> start_ns{0};
+        std::atomic<int64_t> end_ns{0};
+        std::atomic<uint32_t> depth{0};
+    };
+
+    std::array<Slot, CAPACITY> zones;
+    // total zones ever written, the slot is head % CAPACITY
+    std::atomic<uint64_t> head{0};
+    uint32_t thread_index;
+    uint32_t depth = 0;
+public:
+    explicit ProfileRing(uint32_t thread_index) : thread_index(thread_index) {}
+
+    uint32_t enter() { return depth++; }
+    void leave(const ProfileZone& zone);
+
+    // copy the zones that started at or after since_ns, oldest first
+    void collect(int64_t since_ns, std::vector<ProfileZone>& out) const;
+    [[nodiscard]] uint32_t getThreadIndex() const { return thread_index; }
+};
+
+class Profiler {
+private:
+    std::atomic<bool> capturing{false};
+    int64_t capture_start_ns = 0;
+
+    std::mutex rings_mutex;
+    std::vector<std::unique_ptr<ProfileRing>> rings;
+private:
+    Profiler() = default;
+    ProfileRing* registerThread();
+public:
+    static Profiler& get();
+    static int64_t now();
+
+    [[nodiscard]] bool isCapturing() const { return capturing.load(std::memory_order_relaxed); }
+    // ring of the calling thread, created on first use
+    ProfileRing* localRing();
+
+    void startCapture();
+    // stops the capture and writes the trace, returns false if the file could not be written
+    bool stopCapture(const std::string& path);
+    // F3, start or stop and export to a timestamped file
+    void toggleCapture();
+
+    bool writeChromeTrace(const std::string& path);
+};
+
+class ProfileScope {
+private:
+    const char* name;
+    ProfileRing* ring = nullptr;
+    int64_t start_ns = 0;
+    uint32_t depth = 0;
+public:
+    explicit ProfileScope(const char* zone_name) : name(zone_name) {
+        Profiler& profiler = Profiler::get();
+        if (!profiler.isCapturing())
+            return;
+        ring = profiler.localRing();
+        depth = ring->enter();
+        start_ns = Profiler::now();
+    }
+
+    ~ProfileScope() {
+        if (ring != nullptr)
+            ring->leave(ProfileZone{name, start_ns, Profiler::now(), depth});
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define ZPG_PROFILE_CONCAT_INNER(a, b) a##b
+#define ZPG_PROFILE_CONCAT(a, b) ZPG_PROFILE_CONCAT_INNER(a, b)
+#define ZPG_PROFILE_SCOPE(name) ProfileScope ZPG_PROFILE_CONCAT(zpg_profile_scope_, __LINE__)(name)
+
+#else
+
+#define ZPG_PROFILE_SCOPE(name) ((void)0)
+
+#endif //ZPG_ENABLE_PROFILER
+
+#endif //ZPG_PROFILER_H
@@ -0,0 +1,29 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <cinttypes>
+#include <cstdio>
+#include "render_stats.h"
+
+void RenderStats::endFrame() {
+    last = current;
+    current = RenderCounters{};
+    frame_index++;
+
+    if (dump_frames)
+        print(last);
+}
+
+void RenderStats::print(const RenderCounters& counters) {
+    printf("Frame %" PRIu64 ": %u draws (%u instanced, %u indirect with %u commands, %" PRIu64 " vertices), "
+           "%u program switches, %u uniform uploads, %u uniform lookups, %u texture binds, %u stencil changes, "
+           "%u buffer uploads (%" PRIu64 " B)\n",
+           frame_index - 1,
+           counters.draw_calls, counters.instanced_draw_calls,
+           counters.indirect_draw_calls, counters.indirect_commands, counters.vertices,
+           counters.program_switches,
+           counters.uniform_uploads, counters.uniform_lookups,
+           counters.texture_binds, counters.stencil_changes,
+           counters.buffer_uploads, counters.buffer_upload_bytes);
+}
@@ -0,0 +1,55 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_RENDER_STATS_H
+#define ZPG_RENDER_STATS_H
+
+
+#include <atomic>
+#include <cstdint>
+
+// GL work issued during one frame, counted at the call sites that wrap the GL calls
+struct RenderCounters {
+    uint32_t draw_calls = 0; // glDrawArrays and glDrawArraysInstanced
+    uint32_t instanced_draw_calls = 0; // subset of draw_calls
+    uint32_t indirect_draw_calls = 0; // glMultiDrawArraysIndirect, subset of draw_calls
+    uint32_t indirect_commands = 0; // objects drawn by indirect_draw_calls
+    uint64_t vertices = 0; // vertices submitted (indices of indexed draws), instanced draws count every instance
+    uint32_t program_switches = 0; // glUseProgram, including the unbinds
+    uint32_t uniform_uploads = 0; // glUniform*
+    uint32_t uniform_lookups = 0; // glGetUniformLocation outside of shader init
+    uint32_t texture_binds = 0; // glBindTexture, material textures and buffer textures
+    uint32_t stencil_changes = 0; // glStencilFunc
+    uint32_t buffer_uploads = 0; // glBufferSubData into uniform and texture buffers
+    uint64_t buffer_upload_bytes = 0;
+};
+
+//
+// Per-frame render counters. The hot paths only increment plain integers,
+// the thread presenting the frame closes it with endFrame() (Scene::present, or RenderThread with --render-thread),
+// the finished frame stays readable through lastFrame() on that thread.
+// Not synchronized, all counted calls are issued from the thread owning the GL context, only the dump flag is shared.
+//
+class RenderStats {
+private:
+    inline static RenderCounters current{};
+    inline static RenderCounters last{};
+    inline static uint64_t frame_index = 0;
+    // toggled from the key callback, read by the thread presenting
+    inline static std::atomic<bool> dump_frames{false};
+public:
+    // counters of the frame being recorded
+    static RenderCounters& counters() { return current; }
+    [[nodiscard]] static const RenderCounters& lastFrame() { return last; }
+    [[nodiscard]] static uint64_t getFrameIndex() { return frame_index; }
+
+    static void endFrame();
+
+    // F4, print the counters of every finished frame
+    static void toggleDump() { dump_frames = !dump_frames.load(); }
+    static void print(const RenderCounters& counters);
+};
+
+
+#endif //ZPG_RENDER_STATS_H
@@ -0,0 +1,137 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#include <algorithm>
+#include <exception>
+
+#include "thread_pool.h"
+#include "const.h"
+#include "profiler.h"
+
+ThreadPool::ThreadPool(size_t worker_count) {
+    for (size_t i = 0; i <= worker_count; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < worker_count; i++) {
+        workers.emplace_back(&ThreadPool::loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::get() {
+    static ThreadPool pool([] {
+        if (THREAD_POOL_WORKERS >= 0)
+            return static_cast<size_t>(THREAD_POOL_WORKERS);
+        unsigned cores = std::thread::hardware_concurrency();
+        return static_cast<size_t>(cores > 1 ? cores - 1 : 0);
+    }());
+    return pool;
+}
+
+bool ThreadPool::popFront(size_t index, Task& task) {
+    auto& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    queued--;
+    return true;
+}
+
+bool ThreadPool::popBack(size_t index, Task& task) {
+    auto& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+        return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued--;
+    return true;
+}
+
+bool ThreadPool::runTask(size_t index) {
+    Task task;
+    bool found = popFront(index, task);
+    // steal from the back, the owner is still working through the front
+    for (size_t i = 1; !found && i < queues.size(); i++) {
+        found = popBack((index + i) % queues.size(), task);
+    }
+    if (!found)
+        return false;
+    task();
+    return true;
+}
+
+void ThreadPool::loop(size_t index) {
+    while (true) {
+        if (runTask(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping)
+            return;
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    grain = std::max<size_t>(grain, 1);
+    if (count == 0)
+        return;
+    if (workers.empty() || count <= grain) {
+        fn(0, count);
+        return;
+    }
+
+    size_t chunks = (count + grain - 1) / grain;
+    std::atomic<size_t> remaining{chunks};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    // deal the chunks out round robin, stealing balances whatever ends up uneven
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        size_t begin = chunk * grain;
+        size_t end = std::min(begin + grain, count);
+        auto& queue = *queues[chunk % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back([&, begin, end] {
+            try {
+                ZPG_PROFILE_SCOPE("ThreadPool::chunk");
+                fn(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> error_lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+            remaining--;
+        });
+        queued++;
+    }
+    {
+        // taken so a worker between its check and its wait cannot miss the wake up
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    wake.notify_all();
+
+    // help out, then wait for the chunks other threads are still running
+    const size_t own = queues.size() - 1;
+    while (remaining > 0) {
+        if (!runTask(own))
+            std::this_thread::yield();
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
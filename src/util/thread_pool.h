@@ -0,0 +1,66 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+#ifndef ZPG_THREAD_POOL_H
+#define ZPG_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Fixed set of workers for data parallel loops of the simulation thread.
+// Every worker owns a deque, takes its own work from the front and steals from the back of the others
+// once it runs dry, so uneven chunks (deep CentricComposite subtrees, expensive steps) even out.
+// The calling thread works on the loop too, parallelFor returns once every chunk is done.
+//
+class ThreadPool {
+private:
+    using Task = std::function<void()>;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // one per worker, the last one belongs to the calling thread
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    // tasks sitting in any of the queues, workers sleep while there are none
+    std::atomic<size_t> queued{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+private:
+    void loop(size_t index);
+    // runs one task from the queue of the given index, or a stolen one
+    bool runTask(size_t index);
+    bool popFront(size_t index, Task& task);
+    bool popBack(size_t index, Task& task);
+public:
+    // zero workers runs every loop on the calling thread
+    explicit ThreadPool(size_t worker_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // shared pool, one worker per core besides the calling thread (see THREAD_POOL_WORKERS)
+    static ThreadPool& get();
+
+    // calls fn(begin, end) for chunks of at most grain items covering [0, count),
+    // an exception thrown by any chunk is rethrown here after the rest finished
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    [[nodiscard]] size_t getWorkerCount() const { return workers.size(); }
+};
+
+
+#endif //ZPG_THREAD_POOL_H
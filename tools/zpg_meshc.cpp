@@ -0,0 +1,83 @@
+// Creator: Daniel Slavík
+// E-Mail: sla0331@vsb.cz
+// Date of Creation:  16/10/2026
+
+//
+// Offline mesh converter.
+// Writes every assets/static mesh and the given assimp assets as .zmesh files (see mesh_file.h),
+// welded, optimized and compressed exactly as the loaders would do it at startup.
+// Runs from the project root like the application, asset names are relative to assets/.
+//
+// zpg_meshc [--output dir] [asset.obj ...]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/loaders/asset_loader.h"
+#include "core/loaders/model_loader.h"
+#include "core/loaders/static_meshes.h"
+#include "models/mesh_file.h"
+#include "util/const.h"
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--output dir] [asset.obj ...]\n", program);
+}
+
+static void writeMesh(const std::string& path, const EncodedMesh& mesh, const Material* material) {
+    MeshData data = mesh.getData();
+    MeshFile::write(path, data, material);
+    printf("Wrote %s: %d vertices, %d indices, %lld bytes of vertex data\n", path.c_str(), data.vertex_count,
+           data.index_count, static_cast<long long>(data.vertices_size));
+}
+
+int main(int argc, char** argv) {
+    std::string output = MESHES_PATH;
+    std::vector<std::string> assets;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) {
+            output = std::string(argv[++i]) + "/";
+        } else if (arg.rfind("--", 0) == 0) {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            assets.push_back(arg);
+        }
+    }
+
+    try {
+        std::filesystem::create_directories(output);
+
+        for (const StaticMesh* mesh = StaticMeshes::getAll(); mesh->name != nullptr; mesh++) {
+            EncodedMesh encoded = ModelLoader::prepareMesh(mesh->name, mesh->vertices,
+                                                           static_cast<int>(mesh->size / sizeof(float)),
+                                                           mesh->options);
+            writeMesh(output + mesh->name + MESH_FILE_EXTENSION, encoded, nullptr);
+        }
+
+        Assimp::Importer importer;
+        for (const auto& asset: assets) {
+            std::string path = std::string(ASSETS_PATH) + asset;
+            const aiScene* scene = importer.ReadFile(path.c_str(), importOptions);
+            if (!scene) {
+                fprintf(stderr, "%s: %s\n", path.c_str(), importer.GetErrorString());
+                return EXIT_FAILURE;
+            }
+            EncodedMesh encoded = AssetLoader::prepareMesh(scene, asset.c_str());
+            Material material = AssetLoader::readMaterial(scene);
+            // same name the loader looks for, only the directory may differ
+            std::string mesh_path = AssetLoader::getMeshPath(asset.c_str()).substr(strlen(MESHES_PATH));
+            writeMesh(output + mesh_path, encoded, &material);
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}